@@ -0,0 +1,141 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /bench_rows.c, created 2026-10-19 / */
+
+#include <time.h>
+
+#include "sim.h"
+
+// the tick handler and the row state are static; the face's main() is
+// renamed by FACE_CFLAGS, this file brings its own
+#include "../src/Filmplakat2.c"
+#undef main
+
+// The minute tick with the plan prepared in the pause (on_prepare_rows)
+// and without it, host nanoseconds per tick over a simulated week; every
+// other tick drops the prepared plan. Also the simulated time from the
+// tick to the first frame of the new minute.
+
+#define DAY  1387065600         // Sonntag, 15.12.2013 00:00
+#define DAYS 7
+
+typedef struct
+{
+  uint32_t ticks;
+  double   ns;
+  double   max_ns;
+  int64_t  latency_ms;          // tick to first frame, summed
+  int64_t  max_latency_ms;
+} TickCost;
+
+static TickCost cost[2];        // [0] computed, [1] prepared
+static TickCost *current;
+static int64_t tick_ms;
+static bool waiting_for_frame;
+
+static double _now( void )
+{
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void _timed_tick( struct tm *time_ticks, TimeUnits units_changed )
+{
+  double start, ns;
+
+  current = &cost[row_next_prepared];
+  tick_ms = sim_now_ms();
+  waiting_for_frame = true;
+
+  start = _now();
+  on_minute_tick( time_ticks, units_changed );
+  ns = _now() - start;
+
+  ++current->ticks;
+  current->ns += ns;
+  current->max_ns = ns > current->max_ns ? ns : current->max_ns;
+}
+
+static void _on_frame( void )
+{
+  int64_t latency;
+
+  if( !waiting_for_frame )
+  {
+    return;
+  }
+
+  waiting_for_frame = false;
+  latency = sim_now_ms() - tick_ms;
+  current->latency_ms += latency;
+  current->max_latency_ms = latency > current->max_latency_ms ? latency : current->max_latency_ms;
+}
+
+static void _scenario( void )
+{
+  int minute;
+
+  sim_run( 5000 );
+  sim_settle( 10000 );
+
+  tick_timer_service_subscribe( MINUTE_UNIT, _timed_tick );
+  sim_set_frame_observer( _on_frame );
+
+  for( minute = 1; minute <= DAYS * 24 * 60; ++minute )
+  {
+    sim_run_to( DAY + minute * 60 - 1 );
+    if( minute & 1 )
+    {
+      row_next_prepared = false;
+    }
+    sim_run( 1000 );
+  }
+
+  sim_set_frame_observer( NULL );
+}
+
+static void _print( const char *name, const TickCost *c )
+{
+  printf( "%-10s %6u %10.0f %10.0f %12.1f %10lld\n", name, c->ticks,
+          c->ticks ? c->ns / c->ticks : 0.0, c->max_ns,
+          c->ticks ? (double)c->latency_ms / c->ticks : 0.0, (long long)c->max_latency_ms );
+}
+
+int main( void )
+{
+  sim_reset( DAY + 30 );
+  sim_set_battery( (BatteryChargeState){ 80, false, false } );
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+
+  printf( "%-10s %6s %10s %10s %12s %10s\n", "tick", "count", "ns", "max ns", "frame ms", "max ms" );
+  _print( "computed", &cost[0] );
+  _print( "prepared", &cost[1] );
+  return 0;
+}
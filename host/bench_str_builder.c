@@ -0,0 +1,130 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /bench_str_builder.c, created 2026-10-19 / */
+
+#include <time.h>
+
+#include "sim.h"
+
+#include "../src/str_builder.h"
+
+// The date row and the battery label built with str_builder and with the
+// snprintf() calls it replaced, host nanoseconds per text. On the watch
+// snprintf() lives in the firmware, so the app's code size grows by
+// str_builder.o (see make bench) and the cycles are what is saved.
+
+#define RUNS 2000000
+
+static const char *WEEKDAYS[] = { "So", "Mo", "Di", "Mi", "Do", "Fr", "Sa" };
+static const char *MONTHS[] = { "Januar", "Februar", "März", "April", "Mai", "Juni", "Juli",
+                                "August", "September", "Oktober", "November", "Dezember" };
+
+static volatile char sink;
+
+static double _now( void )
+{
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double _date_builder( void )
+{
+  double start = _now();
+  char buf[20];
+  StrBuilder sb;
+  int i;
+
+  for( i = 0; i < RUNS; ++i )
+  {
+    str_builder_init( &sb, buf, sizeof( buf ) );
+    str_builder_append( &sb, WEEKDAYS[i % 7] );
+    str_builder_append_char( &sb, ' ' );
+    str_builder_append_uint( &sb, 1 + i % 31 );
+    str_builder_append( &sb, ". " );
+    str_builder_append( &sb, MONTHS[i % 12] );
+    sink = buf[0];
+  }
+  return ( _now() - start ) / RUNS;
+}
+
+static double _date_snprintf( void )
+{
+  double start = _now();
+  char buf[20];
+  int i;
+
+  for( i = 0; i < RUNS; ++i )
+  {
+    snprintf( buf, sizeof( buf ), "%s %d. %s", WEEKDAYS[i % 7], 1 + i % 31, MONTHS[i % 12] );
+    sink = buf[0];
+  }
+  return ( _now() - start ) / RUNS;
+}
+
+static double _battery_builder( void )
+{
+  double start = _now();
+  char buf[5];
+  StrBuilder sb;
+  int i;
+
+  for( i = 0; i < RUNS; ++i )
+  {
+    str_builder_init( &sb, buf, 4 );
+    str_builder_append_uint( &sb, i % 101 );
+    if( i & 1 )
+    {
+      str_builder_append_char( &sb, '+' );
+    }
+    sink = buf[0];
+  }
+  return ( _now() - start ) / RUNS;
+}
+
+static double _battery_snprintf( void )
+{
+  double start = _now();
+  char buf[5];
+  int i;
+
+  for( i = 0; i < RUNS; ++i )
+  {
+    snprintf( buf, 4, "%d%c", i % 101, ( i & 1 ) ? '+' : '\0' );
+    sink = buf[0];
+  }
+  return ( _now() - start ) / RUNS;
+}
+
+int main( void )
+{
+  printf( "%-14s %12s %12s\n", "ns per text", "str_builder", "snprintf" );
+  printf( "%-14s %12.1f %12.1f\n", "date row", _date_builder(), _date_snprintf() );
+  printf( "%-14s %12.1f %12.1f\n", "battery label", _battery_builder(), _battery_snprintf() );
+  return 0;
+}
@@ -0,0 +1,393 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /energy.c, created 2026-10-19 / */
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+#include "../src/settings_record.h"
+
+// Energy the face adds over one simulated day, per subsystem and settings
+// variant. The day runs through the real face on the simulated clock:
+// the start with its tap window, 1440 minute ticks and, spread evenly over
+// the day, notifications drawn over the face, bluetooth drops (every other
+// one outlasts the alert delay), battery steps of one percent and config
+// opens (the phone asks for the settings and sends them back unchanged).
+//
+//   energy [--notifications <n>] [--bt-drops <n>] [--battery-steps <n>]
+//          [--config-opens <n>] [<coefficient>=<value> ...]
+//
+// The simulator counts what the face does; the coefficients turn it into
+// uAh. The watch's CPU time in the draw procs is estimated from the
+// update procs called, the drawing calls and the pixels they write. The
+// coefficients are rough starting points. Fit them against the hourly
+// telemetry of a real week. The idle current of the watch is not part of
+// the estimate, only what the face adds. Each variant is a face of its own,
+// in a process of its own.
+
+#define DAY 1387065600          // Sonntag, 15.12.2013 00:00
+
+#define EVENT_AT_S   20         // into the minute, the tick's animations are done
+#define SHORT_DROP_MS 1000      // filtered by the face
+#define LONG_DROP_MS  6000      // longer than the face's alert delay
+
+// the face's storage keys (SETTINGS_* in Filmplakat2.c) and message keys
+#define KEY_SEND_KEYS 0
+#define KEY_STATUS    2
+#define KEY_REGULAR   4
+#define KEY_RECORD    7
+
+typedef struct
+{
+  const char *name;
+  bool        regular;
+  bool        status;
+  uint8_t     battery;          // at the start, one percent less per step
+} Variant;
+
+static const Variant VARIANTS[] = {
+  { "italic",  false, false, 80 },
+  { "regular", true,  false, 80 },
+  { "status",  false, true,  80 },
+  { "reduced", false, false, 10 },  // battery at the alert level, no animations
+};
+
+typedef struct
+{
+  const char *name;
+  double      value;
+  const char *unit;
+} Coefficient;
+
+enum
+{
+  COEFF_LAYER_DRAW_US,
+  COEFF_DRAW_CALL_US,
+  COEFF_PIXEL_NS,
+  COEFF_CPU_UA,
+  COEFF_FRAME_UAS,
+  COEFF_MESSAGE_BYTE_UAS,
+  COEFF_PERSIST_WRITE_UAS,
+  COEFF_VIBE_UA,
+  COEFF_ACCEL_UA,
+  COEFF_RADIO_FAST_UA,
+  COEFF_COUNT
+};
+
+static Coefficient coefficients[COEFF_COUNT] = {
+  [COEFF_LAYER_DRAW_US]     = { "layer_draw_us",     30,    "us per update proc" },
+  [COEFF_DRAW_CALL_US]      = { "draw_call_us",      15,    "us per graphics call" },
+  [COEFF_PIXEL_NS]          = { "pixel_ns",          40,    "ns per pixel written" },
+  [COEFF_CPU_UA]            = { "cpu_ua",            20000, "uA while drawing" },
+  [COEFF_FRAME_UAS]         = { "frame_uas",         60,    "uAs per frame to the display" },
+  [COEFF_MESSAGE_BYTE_UAS]  = { "message_byte_uas",  4,     "uAs per AppMessage byte" },
+  [COEFF_PERSIST_WRITE_UAS] = { "persist_write_uas", 400,   "uAs per persist write" },
+  [COEFF_VIBE_UA]           = { "vibe_ua",           80000, "uA vibrating" },
+  [COEFF_ACCEL_UA]          = { "accel_ua",          250,   "uA with tap detection on" },
+  [COEFF_RADIO_FAST_UA]     = { "radio_fast_ua",     300,   "uA more with the reduced sniff interval" },
+};
+
+typedef enum
+{
+  SUB_DRAW,
+  SUB_FRAMES,
+  SUB_MESSAGES,
+  SUB_PERSIST,
+  SUB_VIBE,
+  SUB_ACCEL,
+  SUB_RADIO,
+  SUB_COUNT
+} Subsystem;
+
+static const char *SUBSYSTEM_NAMES[SUB_COUNT] = {
+  "draw (cpu ms)", "frames", "messages (bytes)", "persist (writes)",
+  "vibe (ms)", "accel (ms)", "radio fast (ms)"
+};
+
+static struct
+{
+  uint16_t notifications, bt_drops, battery_steps, config_opens;
+} day = { 40, 8, 10, 1 };
+
+//
+// One variant, in a process of its own
+//
+
+static const Variant *current;
+
+// how many of 'count' events a day fall into this minute
+static uint16_t _due( uint32_t minute, uint32_t count )
+{
+  return ( ( minute + 1 ) * count + 720 ) / ( 24 * 60 ) - ( minute * count + 720 ) / ( 24 * 60 );
+}
+
+static void _config_open( void )
+{
+  uint8_t data[SETTINGS_RECORD_SIZE];
+  SettingsRecord settings;
+  DictionaryIterator *it;
+
+  it = sim_inbox_begin();
+  dict_write_uint8( it, KEY_SEND_KEYS, 1 );
+  sim_inbox_send();
+  sim_run( 2000 );
+
+  settings.value[SETTING_INVERTER_STATE]  = SETTING_DEFAULT_INVERTER_STATE;
+  settings.value[SETTING_STATUS_VISIBLE]  = current->status;
+  settings.value[SETTING_ACCEL_CONFIG]    = SETTING_DEFAULT_ACCEL_CONFIG;
+  settings.value[SETTING_REGULAR_FONTSET] = current->regular;
+  settings_record_pack( &settings, data );
+
+  it = sim_inbox_begin();
+  dict_write_data( it, KEY_RECORD, data, sizeof( data ) );
+  sim_inbox_send();
+}
+
+static void _scenario( void )
+{
+  uint8_t battery = current->battery;
+  uint32_t minute, drops = 0;
+
+  for( minute = 0; minute < 24 * 60; ++minute )
+  {
+    sim_run_to( DAY + minute * 60 + EVENT_AT_S );
+
+    if( _due( minute, day.notifications ) )
+    {
+      sim_notification();
+    }
+    if( _due( minute, day.bt_drops ) )
+    {
+      sim_set_bluetooth( false );
+      sim_run( ( drops++ % 2 ) ? LONG_DROP_MS : SHORT_DROP_MS );
+      sim_set_bluetooth( true );
+    }
+    if( _due( minute, day.battery_steps ) && battery > 1 )
+    {
+      sim_set_battery( (BatteryChargeState){ --battery, false, false } );
+    }
+    if( _due( minute, day.config_opens ) )
+    {
+      _config_open();
+    }
+  }
+  sim_run_to( DAY + 24 * 60 * 60 );
+}
+
+int filmplakat_main( void );
+
+static int _run_variant( const Variant *variant, int fd )
+{
+  current = variant;
+  sim_reset( DAY );
+  persist_write_bool( KEY_REGULAR, variant->regular );
+  persist_write_bool( KEY_STATUS, variant->status );
+  sim_set_battery( (BatteryChargeState){ variant->battery, false, false } );
+  sim_set_bluetooth( true );
+
+  // the settings written above are not the face's
+  sim_reset_stats();
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+
+  return write( fd, sim_stats(), sizeof( SimStats ) ) == sizeof( SimStats ) ? 0 : 2;
+}
+
+//
+// Estimate
+//
+
+static double _c( int coefficient )
+{
+  return coefficients[coefficient].value;
+}
+
+static void _amounts( const SimStats *s, double amount[SUB_COUNT] )
+{
+  amount[SUB_DRAW] = ( s->layer_draws * _c( COEFF_LAYER_DRAW_US ) + s->draw_calls * _c( COEFF_DRAW_CALL_US ) +
+                       s->pixels_touched * _c( COEFF_PIXEL_NS ) / 1000.0 ) / 1000.0;
+  amount[SUB_FRAMES]   = s->frames;
+  amount[SUB_MESSAGES] = s->message_bytes_in + s->message_bytes_out;
+  amount[SUB_PERSIST]  = s->persist_writes;
+  amount[SUB_VIBE]     = s->vibe_ms;
+  amount[SUB_ACCEL]    = s->accel_ms;
+  amount[SUB_RADIO]    = s->reduced_sniff_ms;
+}
+
+// uAs -> uAh, ms -> h
+static void _uah( const double amount[SUB_COUNT], double uah[SUB_COUNT] )
+{
+  uah[SUB_DRAW]     = amount[SUB_DRAW] * _c( COEFF_CPU_UA ) / 3600000.0;
+  uah[SUB_FRAMES]   = amount[SUB_FRAMES] * _c( COEFF_FRAME_UAS ) / 3600.0;
+  uah[SUB_MESSAGES] = amount[SUB_MESSAGES] * _c( COEFF_MESSAGE_BYTE_UAS ) / 3600.0;
+  uah[SUB_PERSIST]  = amount[SUB_PERSIST] * _c( COEFF_PERSIST_WRITE_UAS ) / 3600.0;
+  uah[SUB_VIBE]     = amount[SUB_VIBE] * _c( COEFF_VIBE_UA ) / 3600000.0;
+  uah[SUB_ACCEL]    = amount[SUB_ACCEL] * _c( COEFF_ACCEL_UA ) / 3600000.0;
+  uah[SUB_RADIO]    = amount[SUB_RADIO] * _c( COEFF_RADIO_FAST_UA ) / 3600000.0;
+}
+
+static bool _set_coefficient( const char *arg )
+{
+  const char *eq = strchr( arg, '=' );
+  int i;
+
+  for( i = 0; eq && i < COEFF_COUNT; ++i )
+  {
+    if( strlen( coefficients[i].name ) == (size_t)( eq - arg ) &&
+        strncmp( coefficients[i].name, arg, eq - arg ) == 0 )
+    {
+      coefficients[i].value = atof( eq + 1 );
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool _set_count( int argc, char **argv, int *arg )
+{
+  static const struct { const char *option; uint16_t *count; } OPTIONS[] = {
+    { "--notifications", &day.notifications },
+    { "--bt-drops",      &day.bt_drops },
+    { "--battery-steps", &day.battery_steps },
+    { "--config-opens",  &day.config_opens },
+  };
+  size_t i;
+
+  for( i = 0; i < ARRAY_LENGTH( OPTIONS ) && *arg + 1 < argc; ++i )
+  {
+    if( strcmp( argv[*arg], OPTIONS[i].option ) == 0 )
+    {
+      *OPTIONS[i].count = strtoul( argv[++*arg], NULL, 0 );
+      return true;
+    }
+  }
+  return false;
+}
+
+int main( int argc, char **argv )
+{
+  double amount[ARRAY_LENGTH( VARIANTS )][SUB_COUNT], uah[ARRAY_LENGTH( VARIANTS )][SUB_COUNT];
+  int arg, failed = 0, s;
+  size_t v;
+
+  for( arg = 1; arg < argc; ++arg )
+  {
+    if( !_set_count( argc, argv, &arg ) && !_set_coefficient( argv[arg] ) )
+    {
+      fprintf( stderr, "usage: %s [--notifications <n>] [--bt-drops <n>] [--battery-steps <n>]\n"
+                       "       [--config-opens <n>] [<coefficient>=<value> ...]\n", argv[0] );
+      for( s = 0; s < COEFF_COUNT; ++s )
+      {
+        fprintf( stderr, "  %-18s %8g  %s\n", coefficients[s].name, coefficients[s].value, coefficients[s].unit );
+      }
+      return 2;
+    }
+  }
+
+  for( v = 0; v < ARRAY_LENGTH( VARIANTS ); ++v )
+  {
+    SimStats stats;
+    int fds[2], status;
+    pid_t pid;
+
+    fflush( stdout );
+    if( pipe( fds ) != 0 || ( pid = fork() ) < 0 )
+    {
+      perror( "fork" );
+      return 2;
+    }
+    if( pid == 0 )
+    {
+      close( fds[0] );
+      _exit( _run_variant( &VARIANTS[v], fds[1] ) );
+    }
+
+    close( fds[1] );
+    if( read( fds[0], &stats, sizeof( stats ) ) != sizeof( stats ) )
+    {
+      memset( &stats, 0, sizeof( stats ) );
+    }
+    close( fds[0] );
+    waitpid( pid, &status, 0 );
+
+    if( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+    {
+      printf( "  %s: CRASHED\n", VARIANTS[v].name );
+      ++failed;
+    }
+    _amounts( &stats, amount[v] );
+    _uah( amount[v], uah[v] );
+  }
+
+  printf( "one day: %u notifications, %u bluetooth drops, %u battery steps, %u config opens\n",
+          day.notifications, day.bt_drops, day.battery_steps, day.config_opens );
+  for( s = 0; s < COEFF_COUNT; ++s )
+  {
+    printf( "  %-18s %8g  %s\n", coefficients[s].name, coefficients[s].value, coefficients[s].unit );
+  }
+
+  printf( "\n%-18s", "amount per day" );
+  for( v = 0; v < ARRAY_LENGTH( VARIANTS ); ++v )
+  {
+    printf( " %10s", VARIANTS[v].name );
+  }
+  for( s = 0; s < SUB_COUNT; ++s )
+  {
+    printf( "\n%-18s", SUBSYSTEM_NAMES[s] );
+    for( v = 0; v < ARRAY_LENGTH( VARIANTS ); ++v )
+    {
+      printf( " %10.0f", amount[v][s] );
+    }
+  }
+
+  printf( "\n\n%-18s", "uAh per day" );
+  for( v = 0; v < ARRAY_LENGTH( VARIANTS ); ++v )
+  {
+    printf( " %10s", VARIANTS[v].name );
+  }
+  for( s = 0; s <= SUB_COUNT; ++s )
+  {
+    printf( "\n%-18s", s < SUB_COUNT ? SUBSYSTEM_NAMES[s] : "total" );
+    for( v = 0; v < ARRAY_LENGTH( VARIANTS ); ++v )
+    {
+      double value = 0;
+      int i;
+
+      for( i = 0; i < SUB_COUNT; ++i )
+      {
+        value += ( s == SUB_COUNT || s == i ) ? uah[v][i] : 0;
+      }
+      printf( " %10.1f", value );
+    }
+  }
+  printf( "\n" );
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,483 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /pebble.h, created 2026-10-19 / */
+
+#ifndef __HOST_PEBBLE_H
+#define __HOST_PEBBLE_H
+
+// Pebble SDK 2 stand-in for host builds: the subset of <pebble.h> the face
+// uses, implemented by the simulator in sim*.c. Types and values follow
+// the SDK headers where the sources depend on them (GBitmap, Tuple,
+// dictionary layout, result codes); everything else is opaque.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "resource_ids.auto.h"
+
+#define ARRAY_LENGTH( array ) ( sizeof( array ) / sizeof( ( array )[0] ) )
+
+//
+// Time: the simulated clock, local time is UTC
+//
+
+time_t sim_time( time_t *tloc );
+struct tm* sim_localtime( int64_t t );
+
+// the watch has a 32 bit time_t, the face passes int32_t* as well
+#define time( tloc )   sim_time( tloc )
+#define localtime( t ) sim_localtime( *(t) )
+
+uint16_t time_ms( time_t *t_utc, uint16_t *out_ms );
+
+//
+// Heap: SDK objects and the face's own allocations share the simulated
+// app heap (see sim_heap.c)
+//
+
+void* sim_malloc( size_t size );
+void* sim_calloc( size_t count, size_t size );
+void  sim_free( void *ptr );
+
+#define malloc( size )        sim_malloc( size )
+#define calloc( count, size ) sim_calloc( count, size )
+#define free( ptr )           sim_free( ptr )
+
+size_t heap_bytes_used( void );
+size_t heap_bytes_free( void );
+
+//
+// Logging
+//
+
+typedef enum
+{
+  APP_LOG_LEVEL_ERROR         = 1,
+  APP_LOG_LEVEL_WARNING       = 50,
+  APP_LOG_LEVEL_INFO          = 100,
+  APP_LOG_LEVEL_DEBUG         = 200,
+  APP_LOG_LEVEL_DEBUG_VERBOSE = 255
+} AppLogLevel;
+
+void app_log( uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ... )
+  __attribute__((format( printf, 4, 5 )));
+
+#define APP_LOG( level, fmt, args... ) app_log( level, __FILE__, __LINE__, fmt, ## args )
+
+//
+// Graphics types
+//
+
+typedef struct GPoint { int16_t x, y; } GPoint;
+typedef struct GSize  { int16_t w, h; } GSize;
+typedef struct GRect  { GPoint origin; GSize size; } GRect;
+
+#define GPoint( x, y )       ( (GPoint){ (x), (y) } )
+#define GSize( w, h )        ( (GSize){ (w), (h) } )
+#define GRect( x, y, w, h )  ( (GRect){ { (x), (y) }, { (w), (h) } } )
+#define GPointZero           GPoint( 0, 0 )
+#define GSizeZero            GSize( 0, 0 )
+#define GRectZero            GRect( 0, 0, 0, 0 )
+
+typedef enum
+{
+  GColorClear = ~0,
+  GColorBlack = 0,
+  GColorWhite = 1
+} GColor;
+
+typedef enum
+{
+  GCompOpAssign,
+  GCompOpAssignInverted,
+  GCompOpOr,
+  GCompOpAnd,
+  GCompOpClear,
+  GCompOpSet
+} GCompOp;
+
+typedef enum
+{
+  GCornerNone = 0,
+  GCornerTopLeft = 1 << 0,
+  GCornerTopRight = 1 << 1,
+  GCornerBottomLeft = 1 << 2,
+  GCornerBottomRight = 1 << 3,
+  GCornersAll = 0x0F
+} GCornerMask;
+
+typedef enum
+{
+  GTextOverflowModeWordWrap,
+  GTextOverflowModeTrailingEllipsis,
+  GTextOverflowModeFill
+} GTextOverflowMode;
+
+typedef enum
+{
+  GTextAlignmentLeft,
+  GTextAlignmentCenter,
+  GTextAlignmentRight
+} GTextAlignment;
+
+// 1 bit per pixel, leftmost pixel in the lowest bit of a byte
+typedef struct GBitmap
+{
+  void     *addr;
+  uint16_t  row_size_bytes;
+  uint16_t  info_flags;
+  GRect     bounds;
+} GBitmap;
+
+typedef struct GContext GContext;
+typedef struct SimFont *GFont;
+typedef struct GTextLayoutCache *GTextLayoutCacheRef;
+typedef void *ResHandle;
+
+#define FONT_KEY_GOTHIC_14      "RESOURCE_ID_GOTHIC_14"
+#define FONT_KEY_GOTHIC_14_BOLD "RESOURCE_ID_GOTHIC_14_BOLD"
+#define FONT_KEY_GOTHIC_28      "RESOURCE_ID_GOTHIC_28"
+#define FONT_KEY_GOTHIC_28_BOLD "RESOURCE_ID_GOTHIC_28_BOLD"
+
+ResHandle resource_get_handle( uint32_t resource_id );
+
+GFont fonts_get_system_font( const char *font_key );
+GFont fonts_load_custom_font( ResHandle handle );
+void fonts_unload_custom_font( GFont font );
+
+GBitmap* gbitmap_create_with_resource( uint32_t resource_id );
+GBitmap* gbitmap_create_as_sub_bitmap( const GBitmap *base_bitmap, GRect sub_rect );
+void gbitmap_destroy( GBitmap *bitmap );
+
+void graphics_context_set_stroke_color( GContext *ctx, GColor color );
+void graphics_context_set_fill_color( GContext *ctx, GColor color );
+void graphics_context_set_text_color( GContext *ctx, GColor color );
+void graphics_context_set_compositing_mode( GContext *ctx, GCompOp mode );
+
+void graphics_draw_pixel( GContext *ctx, GPoint point );
+void graphics_draw_rect( GContext *ctx, GRect rect );
+void graphics_fill_rect( GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask );
+void graphics_draw_bitmap_in_rect( GContext *ctx, const GBitmap *bitmap, GRect rect );
+void graphics_draw_text( GContext *ctx, const char *text, GFont font, GRect box,
+                         GTextOverflowMode overflow_mode, GTextAlignment alignment,
+                         GTextLayoutCacheRef layout );
+GSize graphics_text_layout_get_content_size( const char *text, GFont font, GRect box,
+                                             GTextOverflowMode overflow_mode,
+                                             GTextAlignment alignment );
+
+//
+// Layers and windows
+//
+
+typedef struct Layer Layer;
+typedef struct InverterLayer InverterLayer;
+typedef struct Window Window;
+
+typedef void (*LayerUpdateProc)( struct Layer *layer, GContext *ctx );
+
+Layer* layer_create( GRect frame );
+Layer* layer_create_with_data( GRect frame, size_t data_size );
+void layer_destroy( Layer *layer );
+void* layer_get_data( const Layer *layer );
+void layer_set_update_proc( Layer *layer, LayerUpdateProc update_proc );
+void layer_mark_dirty( Layer *layer );
+void layer_set_frame( Layer *layer, GRect frame );
+GRect layer_get_frame( const Layer *layer );
+void layer_set_bounds( Layer *layer, GRect bounds );
+GRect layer_get_bounds( const Layer *layer );
+void layer_set_hidden( Layer *layer, bool hidden );
+bool layer_get_hidden( const Layer *layer );
+void layer_set_clips( Layer *layer, bool clips );
+void layer_add_child( Layer *parent, Layer *child );
+void layer_remove_from_parent( Layer *child );
+
+InverterLayer* inverter_layer_create( GRect frame );
+void inverter_layer_destroy( InverterLayer *inverter_layer );
+Layer* inverter_layer_get_layer( InverterLayer *inverter_layer );
+
+typedef void (*WindowHandler)( struct Window *window );
+
+typedef struct WindowHandlers
+{
+  WindowHandler load;
+  WindowHandler appear;
+  WindowHandler disappear;
+  WindowHandler unload;
+} WindowHandlers;
+
+Window* window_create( void );
+void window_destroy( Window *window );
+void window_set_window_handlers( Window *window, WindowHandlers handlers );
+void window_set_fullscreen( Window *window, bool enabled );
+void window_set_background_color( Window *window, GColor background_color );
+Layer* window_get_root_layer( const Window *window );
+void window_stack_push( Window *window, bool animated );
+
+//
+// Animations
+//
+
+#define ANIMATION_NORMALIZED_MIN 0
+#define ANIMATION_NORMALIZED_MAX 65535
+
+typedef struct Animation Animation;
+
+typedef enum
+{
+  AnimationCurveLinear = 0,
+  AnimationCurveEaseIn = 1,
+  AnimationCurveEaseOut = 2,
+  AnimationCurveEaseInOut = 3
+} AnimationCurve;
+
+typedef void (*AnimationStartedHandler)( struct Animation *animation, void *context );
+typedef void (*AnimationStoppedHandler)( struct Animation *animation, bool finished, void *context );
+
+typedef struct AnimationHandlers
+{
+  AnimationStartedHandler started;
+  AnimationStoppedHandler stopped;
+} AnimationHandlers;
+
+typedef void (*AnimationSetupImplementation)( struct Animation *animation );
+typedef void (*AnimationUpdateImplementation)( struct Animation *animation, const uint32_t time_normalized );
+typedef void (*AnimationTeardownImplementation)( struct Animation *animation );
+
+typedef struct AnimationImplementation
+{
+  AnimationSetupImplementation setup;
+  AnimationUpdateImplementation update;
+  AnimationTeardownImplementation teardown;
+} AnimationImplementation;
+
+Animation* animation_create( void );
+void animation_destroy( Animation *animation );
+void animation_set_delay( Animation *animation, uint32_t delay_ms );
+void animation_set_duration( Animation *animation, uint32_t duration_ms );
+void animation_set_curve( Animation *animation, AnimationCurve curve );
+void animation_set_handlers( Animation *animation, AnimationHandlers callbacks, void *context );
+void animation_set_implementation( Animation *animation, const AnimationImplementation *implementation );
+void* animation_get_context( Animation *animation );
+void animation_schedule( Animation *animation );
+void animation_unschedule( Animation *animation );
+bool animation_is_scheduled( Animation *animation );
+
+//
+// Timers and event services
+//
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)( void *data );
+
+AppTimer* app_timer_register( uint32_t timeout_ms, AppTimerCallback callback, void *callback_data );
+bool app_timer_reschedule( AppTimer *timer_handle, uint32_t new_timeout_ms );
+void app_timer_cancel( AppTimer *timer_handle );
+
+typedef enum
+{
+  SECOND_UNIT = 1 << 0,
+  MINUTE_UNIT = 1 << 1,
+  HOUR_UNIT   = 1 << 2,
+  DAY_UNIT    = 1 << 3,
+  MONTH_UNIT  = 1 << 4,
+  YEAR_UNIT   = 1 << 5
+} TimeUnits;
+
+typedef void (*TickHandler)( struct tm *tick_time, TimeUnits units_changed );
+
+void tick_timer_service_subscribe( TimeUnits tick_units, TickHandler handler );
+void tick_timer_service_unsubscribe( void );
+
+typedef struct
+{
+  uint8_t charge_percent;
+  bool    is_charging;
+  bool    is_plugged;
+} BatteryChargeState;
+
+typedef void (*BatteryStateHandler)( BatteryChargeState charge );
+
+void battery_state_service_subscribe( BatteryStateHandler handler );
+void battery_state_service_unsubscribe( void );
+BatteryChargeState battery_state_service_peek( void );
+
+typedef void (*BluetoothConnectionHandler)( bool connected );
+
+void bluetooth_connection_service_subscribe( BluetoothConnectionHandler handler );
+void bluetooth_connection_service_unsubscribe( void );
+bool bluetooth_connection_service_peek( void );
+
+typedef enum
+{
+  ACCEL_AXIS_X = 0,
+  ACCEL_AXIS_Y = 1,
+  ACCEL_AXIS_Z = 2
+} AccelAxisType;
+
+typedef void (*AccelTapHandler)( AccelAxisType axis, int32_t direction );
+
+void accel_tap_service_subscribe( AccelTapHandler handler );
+void accel_tap_service_unsubscribe( void );
+
+void vibes_short_pulse( void );
+void vibes_long_pulse( void );
+void vibes_double_pulse( void );
+
+//
+// Persistent storage
+//
+
+typedef int32_t status_t;
+
+#define S_SUCCESS         0
+#define E_DOES_NOT_EXIST  -9
+#define E_INVALID_ARGUMENT -4
+
+#define PERSIST_DATA_MAX_LENGTH 256
+
+bool persist_exists( const uint32_t key );
+int persist_get_size( const uint32_t key );
+bool persist_read_bool( const uint32_t key );
+int32_t persist_read_int( const uint32_t key );
+int persist_read_data( const uint32_t key, void *buffer, const size_t buffer_size );
+status_t persist_write_bool( const uint32_t key, const bool value );
+status_t persist_write_int( const uint32_t key, const int32_t value );
+int persist_write_data( const uint32_t key, const void *data, const size_t size );
+status_t persist_delete( const uint32_t key );
+
+//
+// Dictionaries and AppMessage
+//
+
+typedef enum
+{
+  TUPLE_BYTE_ARRAY = 0,
+  TUPLE_CSTRING    = 1,
+  TUPLE_UINT       = 2,
+  TUPLE_INT        = 3
+} TupleType;
+
+typedef struct __attribute__((__packed__))
+{
+  uint32_t key;
+  TupleType type:8;
+  uint16_t length;
+  union
+  {
+    uint8_t  data[0];
+    char     cstring[0];
+    uint8_t  uint8;
+    uint16_t uint16;
+    uint32_t uint32;
+    int8_t   int8;
+    int16_t  int16;
+    int32_t  int32;
+  } value[];
+} Tuple;
+
+typedef struct Dictionary Dictionary;
+
+typedef struct
+{
+  Dictionary *dictionary;
+  const void *end;
+  Tuple      *cursor;
+} DictionaryIterator;
+
+typedef enum
+{
+  DICT_OK = 0,
+  DICT_NOT_ENOUGH_STORAGE = 1 << 1,
+  DICT_INVALID_ARGS = 1 << 2,
+  DICT_INTERNAL_INCONSISTENCY = 1 << 3
+} DictionaryResult;
+
+DictionaryResult dict_write_begin( DictionaryIterator *iter, uint8_t *buffer, const uint16_t size );
+DictionaryResult dict_write_data( DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size );
+DictionaryResult dict_write_cstring( DictionaryIterator *iter, const uint32_t key, const char *cstring );
+DictionaryResult dict_write_uint8( DictionaryIterator *iter, const uint32_t key, const uint8_t value );
+DictionaryResult dict_write_uint16( DictionaryIterator *iter, const uint32_t key, const uint16_t value );
+DictionaryResult dict_write_uint32( DictionaryIterator *iter, const uint32_t key, const uint32_t value );
+uint32_t dict_write_end( DictionaryIterator *iter );
+uint32_t dict_size( DictionaryIterator *iter );
+Tuple* dict_read_begin_from_buffer( DictionaryIterator *iter, const uint8_t *buffer, const uint16_t size );
+Tuple* dict_read_first( DictionaryIterator *iter );
+Tuple* dict_read_next( DictionaryIterator *iter );
+Tuple* dict_find( const DictionaryIterator *iter, const uint32_t key );
+
+typedef enum
+{
+  APP_MSG_OK = 0,
+  APP_MSG_SEND_TIMEOUT = 1 << 1,
+  APP_MSG_SEND_REJECTED = 1 << 2,
+  APP_MSG_NOT_CONNECTED = 1 << 3,
+  APP_MSG_APP_NOT_RUNNING = 1 << 4,
+  APP_MSG_INVALID_ARGS = 1 << 5,
+  APP_MSG_BUSY = 1 << 6,
+  APP_MSG_BUFFER_OVERFLOW = 1 << 7,
+  APP_MSG_ALREADY_RELEASED = 1 << 9,
+  APP_MSG_OUT_OF_MEMORY = 1 << 12,
+  APP_MSG_CLOSED = 1 << 13,
+  APP_MSG_INTERNAL_ERROR = 1 << 14
+} AppMessageResult;
+
+typedef void (*AppMessageInboxReceived)( DictionaryIterator *iterator, void *context );
+typedef void (*AppMessageInboxDropped)( AppMessageResult reason, void *context );
+typedef void (*AppMessageOutboxSent)( DictionaryIterator *iterator, void *context );
+typedef void (*AppMessageOutboxFailed)( DictionaryIterator *iterator, AppMessageResult reason, void *context );
+
+AppMessageResult app_message_open( const uint32_t size_inbound, const uint32_t size_outbound );
+void app_message_deregister_callbacks( void );
+void* app_message_set_context( void *context );
+AppMessageInboxReceived app_message_register_inbox_received( AppMessageInboxReceived received_callback );
+AppMessageInboxDropped app_message_register_inbox_dropped( AppMessageInboxDropped dropped_callback );
+AppMessageOutboxSent app_message_register_outbox_sent( AppMessageOutboxSent sent_callback );
+AppMessageOutboxFailed app_message_register_outbox_failed( AppMessageOutboxFailed failed_callback );
+AppMessageResult app_message_outbox_begin( DictionaryIterator **iterator );
+AppMessageResult app_message_outbox_send( void );
+
+typedef enum
+{
+  SNIFF_INTERVAL_NORMAL,
+  SNIFF_INTERVAL_REDUCED
+} SniffInterval;
+
+void app_comm_set_sniff_interval( const SniffInterval interval );
+SniffInterval app_comm_get_sniff_interval( void );
+
+//
+// Event loop: runs the scenario set with sim_set_scenario()
+//
+
+void app_event_loop( void );
+
+#endif
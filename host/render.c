@@ -0,0 +1,344 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /render.c, created 2026-10-19 / */
+
+#include <errno.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+// Renders the face headless and compares the frames with the goldens: for
+// every case the settled face after start and after the next minute change
+// (<case>.pbm, <case>+1.pbm). The minute change is measured as well, frames,
+// draw calls and pixels per frame, and summed up per fontset, so italic and
+// regular can be compared.
+//
+//   render [--update] <golden dir> [<out dir>]
+//
+// Mismatches are written to <out dir> as <name>.pbm with a <name>.diff.pbm
+// next to it (differing pixels black). --update rewrites the goldens.
+
+#define DAY 1387065600          // Sonntag, 15.12.2013 00:00
+
+// the face's storage keys (SETTINGS_* in Filmplakat2.c)
+#define KEY_INVERTER 1
+#define KEY_STATUS   2
+#define KEY_REGULAR  4
+
+typedef struct
+{
+  const char *name;
+  uint8_t     hour, minute;
+  bool        regular;
+  bool        inverter;
+  bool        status;
+  uint8_t     battery;
+  bool        charging;
+  bool        bluetooth;
+} RenderCase;
+
+static const RenderCase CASES[] = {
+  { "italic-0944",     9, 44, false, false, false, 80, false, true },
+  { "regular-0944",    9, 44, true,  false, false, 80, false, true },
+  { "italic-1227",    12, 27, false, false, false, 80, false, true },
+  { "regular-1227",   12, 27, true,  false, false, 80, false, true },
+  { "italic-1709",    17,  9, false, false, false, 80, false, true },
+  { "regular-1709",   17,  9, true,  false, false, 80, false, true },
+  { "italic-1719",    17, 19, false, false, false, 80, false, true },
+  { "regular-1719",   17, 19, true,  false, false, 80, false, true },
+  { "italic-2359",    23, 59, false, false, false, 80, false, true },
+  { "regular-2359",   23, 59, true,  false, false, 80, false, true },
+  { "inverter-1620",  16, 20, false, true,  false, 80, false, true },
+  { "status-1620",    16, 20, false, false, true,  47, true,  true },
+  { "status-low-bt-off-1620", 16, 20, true, true, true, 5, false, false },
+};
+
+typedef struct
+{
+  uint32_t frames;
+  uint32_t draw_calls;
+  uint64_t pixels;              // touched
+  uint32_t max_draw_calls;      // in one frame
+  uint64_t max_pixels;
+} MinuteCost;
+
+static const char *golden_dir, *out_dir;
+static bool update = false;
+
+static const RenderCase *current;
+static int mismatches;
+static MinuteCost cost;
+static SimStats frame_start;
+
+//
+// PBM (P4): rows packed MSB first, 1 is black
+//
+
+#define PBM_ROW   ( ( SIM_SCREEN_WIDTH + 7 ) / 8 )
+#define PBM_BYTES ( PBM_ROW * SIM_SCREEN_HEIGHT )
+
+static void _capture( uint8_t *bits )
+{
+  int x, y;
+
+  memset( bits, 0, PBM_BYTES );
+  for( y = 0; y < SIM_SCREEN_HEIGHT; ++y )
+  {
+    for( x = 0; x < SIM_SCREEN_WIDTH; ++x )
+    {
+      if( sim_pixel( x, y ) == GColorBlack )
+      {
+        bits[y * PBM_ROW + x / 8] |= 0x80 >> ( x % 8 );
+      }
+    }
+  }
+}
+
+static bool _write_pbm( const char *dir, const char *name, const uint8_t *bits )
+{
+  char path[512];
+  FILE *f;
+
+  snprintf( path, sizeof( path ), "%s/%s.pbm", dir, name );
+  if( ( f = fopen( path, "wb" ) ) == NULL )
+  {
+    fprintf( stderr, "%s: %s\n", path, strerror( errno ) );
+    return false;
+  }
+  fprintf( f, "P4\n%d %d\n", SIM_SCREEN_WIDTH, SIM_SCREEN_HEIGHT );
+  fwrite( bits, 1, PBM_BYTES, f );
+  fclose( f );
+  return true;
+}
+
+static bool _read_pbm( const char *dir, const char *name, uint8_t *bits )
+{
+  char path[512];
+  int w, h;
+  FILE *f;
+  bool ok;
+
+  snprintf( path, sizeof( path ), "%s/%s.pbm", dir, name );
+  if( ( f = fopen( path, "rb" ) ) == NULL )
+  {
+    return false;
+  }
+  ok = fscanf( f, "P4 %d %d", &w, &h ) == 2 && fgetc( f ) != EOF &&
+       w == SIM_SCREEN_WIDTH && h == SIM_SCREEN_HEIGHT &&
+       fread( bits, 1, PBM_BYTES, f ) == PBM_BYTES;
+  fclose( f );
+  return ok;
+}
+
+static void _check_frame( const char *suffix )
+{
+  uint8_t actual[PBM_BYTES], golden[PBM_BYTES], diff[PBM_BYTES];
+  char name[128];
+  int i, differing = 0;
+
+  snprintf( name, sizeof( name ), "%s%s", current->name, suffix );
+  _capture( actual );
+
+  if( update )
+  {
+    if( !_write_pbm( golden_dir, name, actual ) )
+    {
+      ++mismatches;
+    }
+    return;
+  }
+
+  if( !_read_pbm( golden_dir, name, golden ) )
+  {
+    printf( "  %s: no golden, see make goldens\n", name );
+    _write_pbm( out_dir, name, actual );
+    ++mismatches;
+    return;
+  }
+
+  for( i = 0; i < PBM_BYTES; ++i )
+  {
+    diff[i] = actual[i] ^ golden[i];
+    differing += __builtin_popcount( diff[i] );
+  }
+  if( differing )
+  {
+    char diff_name[160];
+
+    printf( "  %s: %d pixels differ, see %s/%s.pbm and .diff.pbm\n", name, differing, out_dir, name );
+    snprintf( diff_name, sizeof( diff_name ), "%s.diff", name );
+    _write_pbm( out_dir, name, actual );
+    _write_pbm( out_dir, diff_name, diff );
+    ++mismatches;
+  }
+}
+
+//
+// One case, in a process of its own (the face keeps its state in statics)
+//
+
+static void _on_frame( void )
+{
+  const SimStats *now = sim_stats();
+  uint32_t draw_calls = now->draw_calls - frame_start.draw_calls;
+  uint64_t pixels = now->pixels_touched - frame_start.pixels_touched;
+
+  ++cost.frames;
+  cost.draw_calls += draw_calls;
+  cost.pixels += pixels;
+  cost.max_draw_calls = draw_calls > cost.max_draw_calls ? draw_calls : cost.max_draw_calls;
+  cost.max_pixels = pixels > cost.max_pixels ? pixels : cost.max_pixels;
+  frame_start = *now;
+}
+
+static void _scenario( void )
+{
+  int64_t next_minute = DAY + current->hour * 3600 + ( current->minute + 1 ) * 60;
+
+  // startup stages, fontset, first animations
+  sim_run( 5000 );
+  sim_settle( 10000 );
+  _check_frame( "" );
+
+  sim_run_to( next_minute - 1 );
+  sim_reset_stats();
+  frame_start = *sim_stats();
+  sim_set_frame_observer( _on_frame );
+  sim_run( 1000 );
+  sim_settle( 10000 );
+  sim_set_frame_observer( NULL );
+  _check_frame( "+1" );
+}
+
+int filmplakat_main( void );
+
+static int _run_case( const RenderCase *c, int fd )
+{
+  current = c;
+  sim_reset( DAY + c->hour * 3600 + c->minute * 60 + 30 );
+
+  persist_write_bool( KEY_REGULAR, c->regular );
+  persist_write_bool( KEY_INVERTER, c->inverter );
+  persist_write_bool( KEY_STATUS, c->status );
+  sim_set_battery( (BatteryChargeState){ c->battery, c->charging, c->charging } );
+  sim_set_bluetooth( c->bluetooth );
+
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+
+  if( write( fd, &cost, sizeof( cost ) ) != sizeof( cost ) )
+  {
+    return 2;
+  }
+  return mismatches ? 1 : 0;
+}
+
+int main( int argc, char **argv )
+{
+  MinuteCost fontset[2] = { { 0 } };
+  int arg = 1, failed = 0;
+  size_t i;
+
+  if( arg < argc && strcmp( argv[arg], "--update" ) == 0 )
+  {
+    update = true;
+    ++arg;
+  }
+  if( arg >= argc )
+  {
+    fprintf( stderr, "usage: %s [--update] <golden dir> [<out dir>]\n", argv[0] );
+    return 2;
+  }
+  golden_dir = argv[arg++];
+  out_dir = arg < argc ? argv[arg] : "build";
+
+  printf( "%-24s %6s %10s %12s %14s\n", "minute change", "frames", "draws", "draws/frame", "pixels/frame" );
+
+  for( i = 0; i < ARRAY_LENGTH( CASES ); ++i )
+  {
+    MinuteCost c = { 0 };
+    int fds[2], status;
+    pid_t pid;
+
+    fflush( stdout );
+    if( pipe( fds ) != 0 || ( pid = fork() ) < 0 )
+    {
+      perror( "fork" );
+      return 2;
+    }
+    if( pid == 0 )
+    {
+      close( fds[0] );
+      fflush( stdout );
+      _exit( _run_case( &CASES[i], fds[1] ) );
+    }
+
+    close( fds[1] );
+    if( read( fds[0], &c, sizeof( c ) ) != sizeof( c ) )
+    {
+      memset( &c, 0, sizeof( c ) );
+    }
+    close( fds[0] );
+    waitpid( pid, &status, 0 );
+
+    if( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+    {
+      printf( "  %s: %s\n", CASES[i].name,
+              WIFEXITED( status ) && WEXITSTATUS( status ) == 1 ? "FAILED" : "CRASHED" );
+      ++failed;
+    }
+
+    printf( "%-24s %6u %10u %12.1f %14.0f\n", CASES[i].name, c.frames, c.draw_calls,
+            c.frames ? (double)c.draw_calls / c.frames : 0.0,
+            c.frames ? (double)c.pixels / c.frames : 0.0 );
+
+    // italic against regular: same minutes, only the pairs count
+    if( !CASES[i].inverter && !CASES[i].status )
+    {
+      MinuteCost *sum = &fontset[CASES[i].regular];
+      sum->frames += c.frames;
+      sum->draw_calls += c.draw_calls;
+      sum->pixels += c.pixels;
+    }
+  }
+
+  printf( "\n%-24s %6s %10s %12s %14s\n", "fontset, all pairs", "frames", "draws", "draws/frame", "pixels/frame" );
+  for( i = 0; i < 2; ++i )
+  {
+    printf( "%-24s %6u %10u %12.1f %14.0f\n", i ? "regular" : "italic",
+            fontset[i].frames, fontset[i].draw_calls,
+            fontset[i].frames ? (double)fontset[i].draw_calls / fontset[i].frames : 0.0,
+            fontset[i].frames ? (double)fontset[i].pixels / fontset[i].frames : 0.0 );
+  }
+
+  if( failed )
+  {
+    printf( "\n%d of %zu cases failed\n", failed, ARRAY_LENGTH( CASES ) );
+  }
+  return failed ? 1 : 0;
+}
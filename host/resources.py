@@ -0,0 +1,233 @@
+#!/usr/bin/env python
+#
+# Turns the resources listed in appinfo.json into C tables for the host
+# build: PNGs become 1-bit images, TTFs become bitmap fonts (the characters
+# of their characterRegex, rasterized with the parser of
+# tools/digit_sprites.py). The system fonts the face uses get a Roboto
+# stand-in. Writes resource_ids.auto.h and resources.c into <out dir>.
+#
+#   resources.py <appinfo.json> <resources dir> <out dir>
+#
+
+import io
+import json
+import math
+import os
+import re
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+import digit_sprites
+
+# stand-ins for the system fonts: key -> (font file, pixel size)
+SYSTEM_FONTS = [
+    ('RESOURCE_ID_GOTHIC_14',      'fonts/roboto/Roboto-Regular_13.ttf', 14),
+    ('RESOURCE_ID_GOTHIC_14_BOLD', 'fonts/roboto/Roboto-Bold_35.ttf',    14),
+    ('RESOURCE_ID_GOTHIC_28',      'fonts/roboto/Roboto-Regular_32.ttf', 28),
+    ('RESOURCE_ID_GOTHIC_28_BOLD', 'fonts/roboto/Roboto-Bold_35.ttf',    28),
+]
+SYSTEM_CHARS = u' .+%0123456789ADFJMNOSabcdefghijklmnopqrstuvwxyzäöüı'
+
+#
+# PNG (8-bit grayscale, RGB, palette) -> 1-bit, white from 50% up
+#
+
+def read_png(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG' % path)
+
+    at, idat, palette = 8, b'', None
+    while at < len(data):
+        length, tag = struct.unpack('>I4s', data[at:at + 8])
+        body = data[at + 8:at + 8 + length]
+        if tag == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif tag == b'PLTE':
+            palette = [tuple(bytearray(body[i:i + 3])) for i in range(0, len(body), 3)]
+        elif tag == b'IDAT':
+            idat += body
+        at += 12 + length
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    if depth != 8 or interlace:
+        raise ValueError('%s: only 8-bit, non-interlaced PNGs are supported' % path)
+
+    raw = bytearray(zlib.decompress(idat))
+    stride = width * channels
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)]
+        for x in range(stride):
+            a = line[x - channels] if x >= channels else 0
+            b = prev[x]
+            c = prev[x - channels] if x >= channels else 0
+            if kind == 1:
+                line[x] = (line[x] + a) & 0xff
+            elif kind == 2:
+                line[x] = (line[x] + b) & 0xff
+            elif kind == 3:
+                line[x] = (line[x] + (a + b) // 2) & 0xff
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[x] = (line[x] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        rows.append(line)
+        prev = line
+
+    def gray(line, x):
+        if color == 3:
+            return sum(palette[line[x]]) // 3
+        if color in (2, 6):
+            return sum(line[x * channels:x * channels + 3]) // 3
+        return line[x * channels]
+
+    return [[1 if gray(line, x) >= 128 else 0 for x in range(width)] for line in rows]
+
+#
+# TTF -> bitmap font, one sample per pixel centre (non-zero winding)
+#
+
+def fill(polygons, left, top, width, height):
+    pixels = [[0] * width for _ in range(height)]
+    for row in range(height):
+        y = top + row + 0.5
+        crossings = []
+        for polygon in polygons:
+            for i in range(len(polygon)):
+                x0, y0 = polygon[i]
+                x1, y1 = polygon[(i + 1) % len(polygon)]
+                if y0 == y1 or not (min(y0, y1) <= y < max(y0, y1)):
+                    continue
+                crossings.append((x0 + (y - y0) * (x1 - x0) / (y1 - y0), 1 if y1 > y0 else -1))
+        crossings.sort()
+        winding = 0
+        for (x, direction), nxt in zip(crossings, crossings[1:] + [None]):
+            winding += direction
+            if winding != 0 and nxt is not None:
+                for col in range(max(0, int(math.ceil(x - left - 0.5))),
+                                 min(width, int(math.ceil(nxt[0] - left - 0.5)))):
+                    pixels[row][col] = 1
+    return pixels
+
+def font_chars(regex):
+    chars, body, i = set(), regex.strip('[]'), 0
+    while i < len(body):
+        if i + 2 < len(body) and body[i + 1] == '-':
+            chars.update(chr(c) for c in range(ord(body[i]), ord(body[i + 2]) + 1))
+            i += 3
+        else:
+            chars.add(body[i])
+            i += 1
+    return sorted(chars)
+
+def read_font(path, size, chars, tracking):
+    font = digit_sprites.Font(path, chars)
+    scale = size / float(font.units_per_em)
+    hhea = font.tables['hhea'][0]
+    descender = font._i16(hhea + 6)
+
+    glyphs = []
+    for ch in sorted(chars):
+        glyph = font.cmap.get(ch)
+        if not glyph:
+            continue
+        polygons = [[(x * scale, -y * scale) for x, y in digit_sprites.flatten(c)]
+                    for c in font.contours(glyph)]
+        advance = int(round(font.advance(glyph) * scale)) + tracking
+        if not polygons:
+            glyphs.append((ord(ch), advance, 0, 0, []))
+            continue
+        left = int(math.floor(min(x for p in polygons for x, y in p)))
+        top = int(math.floor(min(y for p in polygons for x, y in p)))
+        right = int(math.ceil(max(x for p in polygons for x, y in p)))
+        bottom = int(math.ceil(max(y for p in polygons for x, y in p)))
+        glyphs.append((ord(ch), advance, left, top, fill(polygons, left, top, right - left, bottom - top)))
+
+    ascent = int(round(font.ascender * scale))
+    return ascent, int(round((font.ascender - descender) * scale)), glyphs
+
+#
+# Output
+#
+
+def pack(pixels):
+    # rows padded to whole bytes, leftmost pixel in the lowest bit (GBitmap)
+    out = bytearray()
+    for row in pixels:
+        for x in range(0, len(row), 8):
+            out.append(sum(bit << i for i, bit in enumerate(row[x:x + 8])))
+    return out
+
+def c_bytes(data):
+    data = bytearray(data)
+    lines = ['  ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',' for i in range(0, len(data), 16)]
+    return '\n'.join(lines) if lines else '  0'
+
+def write_font(out, name, metrics):
+    ascent, line_height, glyphs = metrics
+    bits, table = bytearray(), []
+    for code, advance, left, top, pixels in glyphs:
+        width = len(pixels[0]) if pixels else 0
+        table.append('  { 0x%04x, %3d, %3d, %3d, %3d, %3d, %5d },' %
+                     (code, advance, left, ascent + top, width, len(pixels), len(bits)))
+        bits += pack(pixels)
+    out.append('static const uint8_t %s_bits[] = {\n%s\n};\n' % (name, c_bytes(bits)))
+    out.append('static const SimGlyph %s_glyphs[] = {\n%s\n};\n' % (name, '\n'.join(table)))
+    out.append('static const SimFont %s = { %d, %d, %d, %s_glyphs, %s_bits };\n' %
+               (name, line_height, ascent, len(glyphs), name, name))
+
+def main(appinfo_path, resources_dir, out_dir):
+    with io.open(appinfo_path, encoding='utf-8') as f:
+        media = json.load(f)['resources']['media']
+
+    ids = ['  INVALID_RESOURCE = 0,', '  DEFAULT_MENU_ICON = 0,']
+    out = ['// generated by host/resources.py from appinfo.json, do not edit', '',
+           '#include "sim_internal.h"', '']
+    table = []
+
+    for n, res in enumerate(media, 1):
+        ids.append('  RESOURCE_ID_%s = %d,' % (res['name'], n))
+        path = os.path.join(resources_dir, res['file'])
+        name = res['name'].lower()
+
+        if res['type'] == 'png':
+            pixels = read_png(path)
+            out.append('static const uint8_t %s_bits[] = {\n%s\n};\n' % (name, c_bytes(pack(pixels))))
+            out.append('static const SimImage %s = { %d, %d, %d, %s_bits };\n' %
+                       (name, len(pixels[0]), len(pixels), (len(pixels[0]) + 7) // 8, name))
+            table.append('  [RESOURCE_ID_%s] = { &%s, NULL },' % (res['name'], name))
+        elif res['type'] == 'font':
+            size = int(re.search(r'_(\d+)\.ttf$', res['file']).group(1))
+            chars = font_chars(res.get('characterRegex', u'[ -~]'))
+            write_font(out, name, read_font(path, size, chars, res.get('trackingAdjust', 0)))
+            table.append('  [RESOURCE_ID_%s] = { NULL, &%s },' % (res['name'], name))
+        else:
+            raise ValueError('%s: resource type %s not supported' % (res['name'], res['type']))
+
+    system = []
+    for key, path, size in SYSTEM_FONTS:
+        name = key.lower()
+        write_font(out, name, read_font(os.path.join(resources_dir, path), size, SYSTEM_CHARS, 0))
+        system.append('  { "%s", &%s },' % (key, name))
+
+    out.append('const SimResource SIM_RESOURCES[] = {\n  [INVALID_RESOURCE] = { NULL, NULL },\n%s\n};\n' %
+               '\n'.join(table))
+    out.append('const uint32_t SIM_RESOURCE_COUNT = %d;\n' % (len(media) + 1))
+    out.append('const SimSystemFont SIM_SYSTEM_FONTS[] = {\n%s\n  { NULL, NULL }\n};\n' % '\n'.join(system))
+
+    with open(os.path.join(out_dir, 'resources.c'), 'w') as f:
+        f.write('\n'.join(out))
+    with open(os.path.join(out_dir, 'resource_ids.auto.h'), 'w') as f:
+        f.write('// generated by host/resources.py from appinfo.json, do not edit\n\n'
+                '#pragma once\n\ntypedef enum {\n%s\n} ResourceId;\n' % '\n'.join(ids))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        sys.stderr.write('usage: resources.py appinfo.json resources_dir out_dir\n')
+        sys.exit(1)
+    main(sys.argv[1], sys.argv[2], sys.argv[3])
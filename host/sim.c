@@ -0,0 +1,628 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim.c, created 2026-10-19 / */
+
+#include <stdarg.h>
+
+#include "sim_internal.h"
+
+#define MAX_TIMERS   64
+#define MAX_PERSIST  32
+
+struct AppTimer
+{
+  int64_t          due;
+  uint32_t         seq;         // registration order for equal due times
+  AppTimerCallback callback;
+  void            *data;
+  bool             live;
+};
+
+typedef struct
+{
+  uint32_t key;
+  int      size;
+  uint8_t  data[PERSIST_DATA_MAX_LENGTH];
+  bool     used;
+} PersistEntry;
+
+SimStats sim_counters;
+
+static int64_t clock_ms = 0;
+static SimScenario scenario = NULL;
+
+static struct AppTimer timers[MAX_TIMERS];
+static uint32_t timer_seq = 0;
+
+static TickHandler tick_handler = NULL;
+static TimeUnits tick_units = 0;
+
+static BatteryStateHandler battery_handler = NULL;
+static BatteryChargeState battery = { 80, false, false };
+static BluetoothConnectionHandler bluetooth_handler = NULL;
+static bool bluetooth = true;
+static AccelTapHandler tap_handler = NULL;
+static SniffInterval sniff = SNIFF_INTERVAL_NORMAL;
+
+static PersistEntry storage[MAX_PERSIST];
+
+static bool log_enabled = false;
+
+//
+// Clock
+//
+
+time_t sim_time( time_t *tloc )
+{
+  time_t now = (time_t)( clock_ms / 1000 );
+
+  if( tloc )
+  {
+    *tloc = now;
+  }
+  return now;
+}
+
+struct tm* sim_localtime( int64_t t )
+{
+  static struct tm result;
+  time_t value = (time_t)t;
+
+  gmtime_r( &value, &result );
+  return &result;
+}
+
+uint16_t time_ms( time_t *t_utc, uint16_t *out_ms )
+{
+  uint16_t ms = (uint16_t)( clock_ms % 1000 );
+
+  if( t_utc )
+  {
+    *t_utc = (time_t)( clock_ms / 1000 );
+  }
+  if( out_ms )
+  {
+    *out_ms = ms;
+  }
+  return ms;
+}
+
+int64_t sim_now_ms( void )
+{
+  return clock_ms;
+}
+
+//
+// Timers
+//
+
+AppTimer* app_timer_register( uint32_t timeout_ms, AppTimerCallback callback, void *callback_data )
+{
+  int i;
+
+  for( i = 0; i < MAX_TIMERS; ++i )
+  {
+    if( !timers[i].live )
+    {
+      timers[i] = (struct AppTimer){
+        .due = clock_ms + timeout_ms,
+        .seq = timer_seq++,
+        .callback = callback,
+        .data = callback_data,
+        .live = true
+      };
+      return &timers[i];
+    }
+  }
+
+  fprintf( stderr, "sim: out of timers\n" );
+  abort();
+}
+
+bool app_timer_reschedule( AppTimer *timer_handle, uint32_t new_timeout_ms )
+{
+  if( timer_handle == NULL || !timer_handle->live )
+  {
+    return false;
+  }
+  timer_handle->due = clock_ms + new_timeout_ms;
+  timer_handle->seq = timer_seq++;
+  return true;
+}
+
+void app_timer_cancel( AppTimer *timer_handle )
+{
+  if( timer_handle )
+  {
+    timer_handle->live = false;
+  }
+}
+
+void sim_post( uint32_t delay_ms, AppTimerCallback callback, void *data )
+{
+  app_timer_register( delay_ms, callback, data );
+}
+
+static struct AppTimer* _next_timer( void )
+{
+  struct AppTimer *next = NULL;
+  int i;
+
+  for( i = 0; i < MAX_TIMERS; ++i )
+  {
+    if( timers[i].live &&
+        ( next == NULL || timers[i].due < next->due ||
+          ( timers[i].due == next->due && timers[i].seq < next->seq ) ) )
+    {
+      next = &timers[i];
+    }
+  }
+  return next;
+}
+
+//
+// Event loop
+//
+
+static int64_t _next_tick( void )
+{
+  int64_t step = ( tick_units & SECOND_UNIT ) ? 1000 : 60000;
+
+  return tick_handler ? ( clock_ms / step + 1 ) * step : -1;
+}
+
+static void _fire_tick( void )
+{
+  struct tm now = *sim_localtime( clock_ms / 1000 );
+  TimeUnits units = SECOND_UNIT;
+
+  if( now.tm_sec == 0 )
+  {
+    units |= MINUTE_UNIT;
+    if( now.tm_min == 0 )
+    {
+      units |= HOUR_UNIT;
+      if( now.tm_hour == 0 )
+      {
+        units |= DAY_UNIT;
+        if( now.tm_mday == 1 )
+        {
+          units |= MONTH_UNIT;
+          if( now.tm_mon == 0 )
+          {
+            units |= YEAR_UNIT;
+          }
+        }
+      }
+    }
+  }
+
+  if( units & tick_units )
+  {
+    ++sim_counters.ticks;
+    tick_handler( &now, units );
+  }
+}
+
+// time passes: what is switched on meanwhile is accounted for
+static void _advance( int64_t to )
+{
+  int64_t elapsed = to - clock_ms;
+
+  if( tap_handler )
+  {
+    sim_counters.accel_ms += elapsed;
+  }
+  if( sniff == SNIFF_INTERVAL_REDUCED )
+  {
+    sim_counters.reduced_sniff_ms += elapsed;
+  }
+  clock_ms = to;
+}
+
+static void _run_until( int64_t end )
+{
+  for( ;; )
+  {
+    struct AppTimer *timer = _next_timer();
+    int64_t tick = _next_tick();
+    int64_t frame = sim_animation_next_frame();
+    int64_t next = end + 1;
+
+    if( timer && timer->due < next )
+    {
+      next = timer->due < clock_ms ? clock_ms : timer->due;
+    }
+    if( tick >= 0 && tick < next )
+    {
+      next = tick;
+    }
+    if( frame >= 0 && frame < next )
+    {
+      next = frame;
+    }
+    if( next > end )
+    {
+      break;
+    }
+
+    _advance( next );
+
+    // equal times: timers, then the tick, then the animation frame
+    if( timer && timer->due <= clock_ms )
+    {
+      timer->live = false;
+      ++sim_counters.timers;
+      timer->callback( timer->data );
+    }
+    else if( tick == clock_ms )
+    {
+      _fire_tick();
+    }
+    else
+    {
+      sim_animation_frame();
+    }
+    sim_render();
+  }
+
+  _advance( end );
+}
+
+void sim_run( uint32_t ms )
+{
+  _run_until( clock_ms + ms );
+}
+
+void sim_run_to( int64_t time )
+{
+  if( time * 1000 > clock_ms )
+  {
+    _run_until( time * 1000 );
+  }
+}
+
+bool sim_settle( uint32_t max_ms )
+{
+  int64_t end = clock_ms + max_ms;
+
+  while( sim_animating() && clock_ms < end )
+  {
+    sim_run( SIM_FRAME_MS );
+  }
+  return !sim_animating();
+}
+
+bool sim_animating( void )
+{
+  return sim_animation_next_frame() >= 0;
+}
+
+void sim_set_scenario( SimScenario run )
+{
+  scenario = run;
+}
+
+void app_event_loop( void )
+{
+  // whatever init() left dirty is the first frame
+  sim_render();
+
+  if( scenario )
+  {
+    scenario();
+  }
+}
+
+void sim_reset( int64_t start_time )
+{
+  clock_ms = start_time * 1000;
+  scenario = NULL;
+
+  memset( timers, 0, sizeof( timers ) );
+  timer_seq = 0;
+
+  tick_handler = NULL;
+  tick_units = 0;
+  battery_handler = NULL;
+  battery = (BatteryChargeState){ 80, false, false };
+  bluetooth_handler = NULL;
+  bluetooth = true;
+  tap_handler = NULL;
+  sniff = SNIFF_INTERVAL_NORMAL;
+
+  memset( storage, 0, sizeof( storage ) );
+  log_enabled = getenv( "SIM_LOG" ) != NULL;
+
+  sim_heap_reset();
+  sim_graphics_reset();
+  sim_animation_reset();
+  sim_message_reset();
+  sim_reset_stats();
+}
+
+const SimStats* sim_stats( void )
+{
+  return &sim_counters;
+}
+
+void sim_reset_stats( void )
+{
+  memset( &sim_counters, 0, sizeof( sim_counters ) );
+}
+
+//
+// Event services
+//
+
+void tick_timer_service_subscribe( TimeUnits units, TickHandler handler )
+{
+  tick_units = units;
+  tick_handler = handler;
+}
+
+void tick_timer_service_unsubscribe( void )
+{
+  tick_handler = NULL;
+  tick_units = 0;
+}
+
+void battery_state_service_subscribe( BatteryStateHandler handler )
+{
+  battery_handler = handler;
+}
+
+void battery_state_service_unsubscribe( void )
+{
+  battery_handler = NULL;
+}
+
+BatteryChargeState battery_state_service_peek( void )
+{
+  return battery;
+}
+
+void sim_set_battery( BatteryChargeState charge )
+{
+  battery = charge;
+  if( battery_handler )
+  {
+    battery_handler( charge );
+    sim_render();
+  }
+}
+
+void bluetooth_connection_service_subscribe( BluetoothConnectionHandler handler )
+{
+  bluetooth_handler = handler;
+}
+
+void bluetooth_connection_service_unsubscribe( void )
+{
+  bluetooth_handler = NULL;
+}
+
+bool bluetooth_connection_service_peek( void )
+{
+  return bluetooth;
+}
+
+void sim_set_bluetooth( bool connected )
+{
+  bluetooth = connected;
+  sim_message_connected( connected );
+  if( bluetooth_handler )
+  {
+    bluetooth_handler( connected );
+    sim_render();
+  }
+}
+
+void accel_tap_service_subscribe( AccelTapHandler handler )
+{
+  tap_handler = handler;
+}
+
+void accel_tap_service_unsubscribe( void )
+{
+  tap_handler = NULL;
+}
+
+void sim_tap( AccelAxisType axis, int32_t direction )
+{
+  if( tap_handler )
+  {
+    tap_handler( axis, direction );
+    sim_render();
+  }
+}
+
+void vibes_short_pulse( void )
+{
+  sim_counters.vibe_ms += SIM_VIBE_SHORT_MS;
+}
+
+void vibes_long_pulse( void )
+{
+  sim_counters.vibe_ms += SIM_VIBE_LONG_MS;
+}
+
+void vibes_double_pulse( void )
+{
+  sim_counters.vibe_ms += SIM_VIBE_DOUBLE_MS;
+}
+
+void app_comm_set_sniff_interval( const SniffInterval interval )
+{
+  sniff = interval;
+}
+
+SniffInterval app_comm_get_sniff_interval( void )
+{
+  return sniff;
+}
+
+//
+// Persistent storage
+//
+
+static PersistEntry* _persist_find( uint32_t key, bool create )
+{
+  PersistEntry *unused = NULL;
+  int i;
+
+  for( i = 0; i < MAX_PERSIST; ++i )
+  {
+    if( storage[i].used && storage[i].key == key )
+    {
+      return &storage[i];
+    }
+    if( !storage[i].used && unused == NULL )
+    {
+      unused = &storage[i];
+    }
+  }
+
+  if( create && unused )
+  {
+    memset( unused, 0, sizeof( *unused ) );
+    unused->used = true;
+    unused->key = key;
+    return unused;
+  }
+  return NULL;
+}
+
+bool persist_exists( const uint32_t key )
+{
+  return _persist_find( key, false ) != NULL;
+}
+
+int persist_get_size( const uint32_t key )
+{
+  PersistEntry *entry = _persist_find( key, false );
+  return entry ? entry->size : E_DOES_NOT_EXIST;
+}
+
+int persist_read_data( const uint32_t key, void *buffer, const size_t buffer_size )
+{
+  PersistEntry *entry = _persist_find( key, false );
+  int size;
+
+  if( entry == NULL )
+  {
+    return E_DOES_NOT_EXIST;
+  }
+  size = entry->size < (int)buffer_size ? entry->size : (int)buffer_size;
+  memcpy( buffer, entry->data, size );
+  return size;
+}
+
+bool persist_read_bool( const uint32_t key )
+{
+  bool value = false;
+
+  persist_read_data( key, &value, sizeof( value ) );
+  return value;
+}
+
+int32_t persist_read_int( const uint32_t key )
+{
+  int32_t value = 0;
+
+  persist_read_data( key, &value, sizeof( value ) );
+  return value;
+}
+
+int persist_write_data( const uint32_t key, const void *data, const size_t size )
+{
+  PersistEntry *entry;
+
+  if( size > PERSIST_DATA_MAX_LENGTH )
+  {
+    return E_INVALID_ARGUMENT;
+  }
+  if( ( entry = _persist_find( key, true ) ) == NULL )
+  {
+    fprintf( stderr, "sim: out of storage keys\n" );
+    abort();
+  }
+
+  memcpy( entry->data, data, size );
+  entry->size = (int)size;
+
+  ++sim_counters.persist_writes;
+  sim_counters.persist_bytes += size;
+  return (int)size;
+}
+
+status_t persist_write_bool( const uint32_t key, const bool value )
+{
+  return persist_write_data( key, &value, sizeof( value ) ) < 0 ? E_INVALID_ARGUMENT : S_SUCCESS;
+}
+
+status_t persist_write_int( const uint32_t key, const int32_t value )
+{
+  return persist_write_data( key, &value, sizeof( value ) ) < 0 ? E_INVALID_ARGUMENT : S_SUCCESS;
+}
+
+status_t persist_delete( const uint32_t key )
+{
+  PersistEntry *entry = _persist_find( key, false );
+
+  if( entry == NULL )
+  {
+    return E_DOES_NOT_EXIST;
+  }
+  entry->used = false;
+  return S_SUCCESS;
+}
+
+//
+// Logging, printed with SIM_LOG set
+//
+
+void app_log( uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ... )
+{
+  va_list args;
+
+  if( log_level <= APP_LOG_LEVEL_WARNING )
+  {
+    ++sim_counters.log_errors;
+  }
+  if( !log_enabled )
+  {
+    return;
+  }
+
+  fprintf( stderr, "[%lld.%03lld] %s:%d ", (long long)( clock_ms / 1000 ),
+           (long long)( clock_ms % 1000 ), src_filename, src_line_number );
+  va_start( args, fmt );
+  vfprintf( stderr, fmt, args );
+  va_end( args );
+  fputc( '\n', stderr );
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim.h, created 2026-10-19 / */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+// Host simulator for the face: the SDK calls of pebble.h run against a
+// simulated clock, a 144x168 1-bit framebuffer and in-memory services.
+//
+// A harness resets the simulator, sets a scenario and calls the app's
+// main(). app_event_loop() runs the scenario, which drives the clock
+// (sim_run) and injects events (battery, bluetooth, taps, messages from
+// the phone); main() returns after it like on the watch.
+//
+// Time only moves in sim_run(): timers, minute ticks and animation frames
+// fire in order, after each event a dirty layer tree is rendered once.
+//
+// pebble.h redefines time(), localtime() and malloc(), system headers have
+// to be included before it.
+
+#include <pebble.h>
+
+#define SIM_SCREEN_WIDTH  144
+#define SIM_SCREEN_HEIGHT 168
+
+#define SIM_FRAME_MS           33     // animation frame interval
+#define SIM_HEAP_SIZE          24576  // app heap of an SDK 2 watchface
+#define SIM_MESSAGE_LATENCY_MS 100    // outbox send until the ack arrives
+
+#define SIM_VIBE_SHORT_MS  100
+#define SIM_VIBE_LONG_MS   500
+#define SIM_VIBE_DOUBLE_MS 300        // two short pulses with a pause
+
+typedef struct
+{
+  uint32_t frames;              // render passes
+  uint32_t layer_draws;         // update procs called
+  uint32_t draw_calls;          // graphics_draw_* / graphics_fill_* calls
+  uint64_t pixels_touched;      // pixel writes inside the clip
+  uint64_t pixels_changed;      // pixels that differ from the frame before
+  uint32_t animations;          // animation_schedule() calls
+  uint32_t animations_unfinished;
+  uint32_t animation_frames;    // frame steps with an animation running
+  uint32_t timers;              // timer callbacks fired
+  uint32_t ticks;               // tick handler calls
+  uint32_t messages_out;
+  uint32_t message_bytes_out;
+  uint32_t messages_in;
+  uint32_t message_bytes_in;
+  uint32_t persist_writes;
+  uint32_t persist_bytes;
+  uint32_t vibe_ms;
+  uint64_t accel_ms;            // tap service subscribed
+  uint64_t reduced_sniff_ms;    // radio in SNIFF_INTERVAL_REDUCED
+  uint32_t log_errors;          // APP_LOG_LEVEL_ERROR / _WARNING
+} SimStats;
+
+typedef struct
+{
+  uint32_t used;                // bytes in live blocks, headers included
+  uint32_t peak;
+  uint32_t live;                // live allocations
+  uint32_t allocs;              // allocations so far
+  uint32_t failed;              // allocations that did not fit
+  uint32_t free_bytes;
+  uint32_t largest_free;        // largest block malloc() could still get
+} SimHeapInfo;
+
+typedef void (*SimScenario)( void );
+typedef void (*SimFrameObserver)( void );
+typedef void (*SimPhone)( DictionaryIterator *received );
+
+// start over at the given unix time (also the local time), all SDK state,
+// storage and the heap are cleared
+void sim_reset( int64_t start_time );
+void sim_set_scenario( SimScenario scenario );
+
+int64_t sim_now_ms( void );
+void sim_run( uint32_t ms );
+void sim_run_to( int64_t time );            // unix time, whole seconds
+bool sim_settle( uint32_t max_ms );         // run until no animation is left
+bool sim_animating( void );
+
+void sim_set_battery( BatteryChargeState charge );
+void sim_set_bluetooth( bool connected );
+void sim_tap( AccelAxisType axis, int32_t direction );
+void sim_notification( void );              // shown over the face, which is drawn again
+
+// messages from the phone: write with dict_write_*(), send to the app
+DictionaryIterator* sim_inbox_begin( void );
+void sim_inbox_send( void );
+
+// messages to the phone, NULL drops them (acked nevertheless)
+void sim_set_phone( SimPhone phone );
+
+void sim_set_frame_observer( SimFrameObserver observer );
+uint8_t sim_pixel( int16_t x, int16_t y );  // GColorBlack / GColorWhite
+
+const SimStats* sim_stats( void );
+void sim_reset_stats( void );
+SimHeapInfo sim_heap_info( void );
+
+#endif
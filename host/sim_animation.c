@@ -0,0 +1,275 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim_animation.c, created 2026-10-19 / */
+
+#include "sim_internal.h"
+
+// Animations step on the frame clock: the first frame comes when the delay
+// is over (started, setup, update), then one every SIM_FRAME_MS until the
+// duration has passed (update with ANIMATION_NORMALIZED_MAX, teardown,
+// stopped). Unscheduling tears down and reports stopped( false ).
+
+#define MAX_ANIMATIONS 32
+
+struct Animation
+{
+  uint32_t                       delay;
+  uint32_t                       duration;
+  AnimationCurve                 curve;
+  AnimationHandlers              handlers;
+  void                          *context;
+  const AnimationImplementation *implementation;
+
+  bool                           scheduled;
+  bool                           running;     // started handler called
+  int64_t                        start;       // after the delay
+  int64_t                        next;        // next frame
+};
+
+static Animation *animations[MAX_ANIMATIONS];
+
+void sim_animation_reset( void )
+{
+  memset( animations, 0, sizeof( animations ) );
+}
+
+Animation* animation_create( void )
+{
+  Animation *animation = calloc( 1, sizeof( Animation ) );
+  int i;
+
+  if( animation == NULL )
+  {
+    return NULL;
+  }
+  animation->duration = 250;
+
+  for( i = 0; i < MAX_ANIMATIONS; ++i )
+  {
+    if( animations[i] == NULL )
+    {
+      animations[i] = animation;
+      return animation;
+    }
+  }
+
+  fprintf( stderr, "sim: out of animations\n" );
+  abort();
+}
+
+void animation_destroy( Animation *animation )
+{
+  int i;
+
+  if( animation == NULL )
+  {
+    return;
+  }
+  animation_unschedule( animation );
+
+  for( i = 0; i < MAX_ANIMATIONS; ++i )
+  {
+    if( animations[i] == animation )
+    {
+      animations[i] = NULL;
+    }
+  }
+  free( animation );
+}
+
+void animation_set_delay( Animation *animation, uint32_t delay_ms )
+{
+  animation->delay = delay_ms;
+}
+
+void animation_set_duration( Animation *animation, uint32_t duration_ms )
+{
+  animation->duration = duration_ms;
+}
+
+void animation_set_curve( Animation *animation, AnimationCurve curve )
+{
+  animation->curve = curve;
+}
+
+void animation_set_handlers( Animation *animation, AnimationHandlers callbacks, void *context )
+{
+  animation->handlers = callbacks;
+  animation->context = context;
+}
+
+void animation_set_implementation( Animation *animation, const AnimationImplementation *implementation )
+{
+  animation->implementation = implementation;
+}
+
+void* animation_get_context( Animation *animation )
+{
+  return animation->context;
+}
+
+bool animation_is_scheduled( Animation *animation )
+{
+  return animation->scheduled;
+}
+
+void animation_schedule( Animation *animation )
+{
+  if( animation->scheduled )
+  {
+    animation_unschedule( animation );
+  }
+
+  animation->scheduled = true;
+  animation->running = false;
+  animation->start = sim_now_ms() + animation->delay;
+  animation->next = animation->start;
+  ++sim_counters.animations;
+}
+
+static void _stop( Animation *animation, bool finished )
+{
+  bool running = animation->running;
+
+  animation->scheduled = false;
+  animation->running = false;
+
+  if( running && animation->implementation && animation->implementation->teardown )
+  {
+    animation->implementation->teardown( animation );
+  }
+  if( animation->handlers.stopped )
+  {
+    animation->handlers.stopped( animation, finished, animation->context );
+  }
+}
+
+void animation_unschedule( Animation *animation )
+{
+  if( animation && animation->scheduled )
+  {
+    ++sim_counters.animations_unfinished;
+    _stop( animation, false );
+  }
+}
+
+static uint32_t _curve( AnimationCurve curve, uint32_t t )
+{
+  uint64_t max = ANIMATION_NORMALIZED_MAX;
+
+  switch( curve )
+  {
+    case AnimationCurveEaseIn:
+      return (uint32_t)( (uint64_t)t * t / max );
+    case AnimationCurveEaseOut:
+      return (uint32_t)( max - ( max - t ) * ( max - t ) / max );
+    case AnimationCurveEaseInOut:
+      if( t < max / 2 )
+      {
+        return (uint32_t)( 2 * (uint64_t)t * t / max );
+      }
+      return (uint32_t)( max - 2 * ( max - t ) * ( max - t ) / max );
+    default:
+      return t;
+  }
+}
+
+int64_t sim_animation_next_frame( void )
+{
+  int64_t next = -1;
+  int i;
+
+  for( i = 0; i < MAX_ANIMATIONS; ++i )
+  {
+    if( animations[i] && animations[i]->scheduled && ( next < 0 || animations[i]->next < next ) )
+    {
+      next = animations[i]->next;
+    }
+  }
+  return next;
+}
+
+void sim_animation_frame( void )
+{
+  int64_t now = sim_now_ms();
+  int i;
+
+  ++sim_counters.animation_frames;
+
+  // handlers may schedule, unschedule or destroy any animation
+  for( i = 0; i < MAX_ANIMATIONS; ++i )
+  {
+    Animation *animation = animations[i];
+    int64_t elapsed;
+
+    if( animation == NULL || !animation->scheduled || animation->next > now )
+    {
+      continue;
+    }
+
+    if( !animation->running )
+    {
+      animation->running = true;
+      if( animation->handlers.started )
+      {
+        animation->handlers.started( animation, animation->context );
+      }
+      if( animation->implementation && animation->implementation->setup && animation->running )
+      {
+        animation->implementation->setup( animation );
+      }
+      if( animations[i] != animation || !animation->scheduled )
+      {
+        continue;
+      }
+    }
+
+    elapsed = now - animation->start;
+    if( elapsed >= animation->duration )
+    {
+      if( animation->implementation && animation->implementation->update )
+      {
+        animation->implementation->update( animation, ANIMATION_NORMALIZED_MAX );
+      }
+      if( animations[i] == animation && animation->scheduled )
+      {
+        _stop( animation, true );
+      }
+      continue;
+    }
+
+    if( animation->implementation && animation->implementation->update )
+    {
+      animation->implementation->update( animation,
+          _curve( animation->curve, (uint32_t)( elapsed * ANIMATION_NORMALIZED_MAX / animation->duration ) ) );
+    }
+    if( animations[i] == animation && animation->scheduled )
+    {
+      animation->next = now + SIM_FRAME_MS;
+    }
+  }
+}
@@ -0,0 +1,823 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim_graphics.c, created 2026-10-19 / */
+
+#include "sim_internal.h"
+
+// Layers, windows and the 1-bit framebuffer. A render pass draws the whole
+// window like the watch does: background, then the layer tree depth first,
+// every layer clipped to its frame and to its parents. Fonts and images
+// come from the tables resources.py generates.
+
+#define BITMAP_HEAP_ALLOCATED 0x0001   // info_flags: bits follow the struct
+
+struct Layer
+{
+  GRect            frame;
+  GRect            bounds;
+  bool             hidden;
+  bool             clips;
+  bool             inverter;
+  struct Layer    *parent;
+  struct Layer    *first_child;
+  struct Layer    *next_sibling;
+  LayerUpdateProc  update_proc;
+  Window          *window;
+  uint8_t          data[];
+};
+
+struct InverterLayer
+{
+  Layer *layer;
+};
+
+struct Window
+{
+  Layer          *root;
+  GColor          background;
+  WindowHandlers  handlers;
+  bool            fullscreen;
+  bool            loaded;
+};
+
+struct GContext
+{
+  GPoint  offset;               // drawing origin, screen coordinates
+  GRect   clip;                 // screen coordinates
+  GColor  stroke;
+  GColor  fill;
+  GColor  text;
+  GCompOp op;
+};
+
+static uint8_t framebuffer[SIM_SCREEN_HEIGHT][SIM_SCREEN_WIDTH];
+static uint8_t previous[SIM_SCREEN_HEIGHT][SIM_SCREEN_WIDTH];
+static Window *top_window = NULL;
+static bool dirty = false;
+static SimFrameObserver observer = NULL;
+
+void sim_graphics_reset( void )
+{
+  memset( framebuffer, GColorBlack, sizeof( framebuffer ) );
+  top_window = NULL;
+  dirty = false;
+  observer = NULL;
+}
+
+void sim_set_frame_observer( SimFrameObserver frame_observer )
+{
+  observer = frame_observer;
+}
+
+uint8_t sim_pixel( int16_t x, int16_t y )
+{
+  if( x < 0 || y < 0 || x >= SIM_SCREEN_WIDTH || y >= SIM_SCREEN_HEIGHT )
+  {
+    return GColorBlack;
+  }
+  return framebuffer[y][x];
+}
+
+//
+// Pixels
+//
+
+static GRect _intersect( GRect a, GRect b )
+{
+  int16_t x0 = a.origin.x > b.origin.x ? a.origin.x : b.origin.x;
+  int16_t y0 = a.origin.y > b.origin.y ? a.origin.y : b.origin.y;
+  int16_t x1 = a.origin.x + a.size.w < b.origin.x + b.size.w ? a.origin.x + a.size.w : b.origin.x + b.size.w;
+  int16_t y1 = a.origin.y + a.size.h < b.origin.y + b.size.h ? a.origin.y + a.size.h : b.origin.y + b.size.h;
+
+  if( x1 <= x0 || y1 <= y0 )
+  {
+    return GRectZero;
+  }
+  return GRect( x0, y0, x1 - x0, y1 - y0 );
+}
+
+static void _put( GContext *ctx, int x, int y, uint8_t color )
+{
+  x += ctx->offset.x;
+  y += ctx->offset.y;
+
+  if( x < ctx->clip.origin.x || y < ctx->clip.origin.y ||
+      x >= ctx->clip.origin.x + ctx->clip.size.w || y >= ctx->clip.origin.y + ctx->clip.size.h )
+  {
+    return;
+  }
+  framebuffer[y][x] = color;
+  ++sim_counters.pixels_touched;
+}
+
+static uint8_t _get( GContext *ctx, int x, int y )
+{
+  return framebuffer[y + ctx->offset.y][x + ctx->offset.x];
+}
+
+static bool _visible( GContext *ctx, int x, int y )
+{
+  x += ctx->offset.x;
+  y += ctx->offset.y;
+  return x >= ctx->clip.origin.x && y >= ctx->clip.origin.y &&
+         x < ctx->clip.origin.x + ctx->clip.size.w && y < ctx->clip.origin.y + ctx->clip.size.h;
+}
+
+static uint8_t _bit( const uint8_t *bits, uint16_t row_size_bytes, int x, int y )
+{
+  return ( bits[y * row_size_bytes + x / 8] >> ( x % 8 ) ) & 1;
+}
+
+// 1-bit compositing as on the watch, src and dst are 0 (black) or 1 (white)
+static uint8_t _composite( GCompOp op, uint8_t src, uint8_t dst )
+{
+  switch( op )
+  {
+    case GCompOpAssign:         return src;
+    case GCompOpAssignInverted: return !src;
+    case GCompOpOr:             return dst | src;
+    case GCompOpAnd:            return dst & src;
+    case GCompOpClear:          return dst & !src;
+    case GCompOpSet:            return dst | !src;
+  }
+  return src;
+}
+
+//
+// Drawing
+//
+
+void graphics_context_set_stroke_color( GContext *ctx, GColor color )
+{
+  ctx->stroke = color;
+}
+
+void graphics_context_set_fill_color( GContext *ctx, GColor color )
+{
+  ctx->fill = color;
+}
+
+void graphics_context_set_text_color( GContext *ctx, GColor color )
+{
+  ctx->text = color;
+}
+
+void graphics_context_set_compositing_mode( GContext *ctx, GCompOp mode )
+{
+  ctx->op = mode;
+}
+
+void graphics_draw_pixel( GContext *ctx, GPoint point )
+{
+  ++sim_counters.draw_calls;
+  if( ctx->stroke != GColorClear )
+  {
+    _put( ctx, point.x, point.y, ctx->stroke );
+  }
+}
+
+void graphics_draw_rect( GContext *ctx, GRect rect )
+{
+  int i;
+
+  ++sim_counters.draw_calls;
+  if( ctx->stroke == GColorClear || rect.size.w <= 0 || rect.size.h <= 0 )
+  {
+    return;
+  }
+
+  for( i = 0; i < rect.size.w; ++i )
+  {
+    _put( ctx, rect.origin.x + i, rect.origin.y, ctx->stroke );
+    _put( ctx, rect.origin.x + i, rect.origin.y + rect.size.h - 1, ctx->stroke );
+  }
+  for( i = 1; i < rect.size.h - 1; ++i )
+  {
+    _put( ctx, rect.origin.x, rect.origin.y + i, ctx->stroke );
+    _put( ctx, rect.origin.x + rect.size.w - 1, rect.origin.y + i, ctx->stroke );
+  }
+}
+
+// the corners are not rounded, the face only fills with radius 0
+void graphics_fill_rect( GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask )
+{
+  int x, y;
+
+  ++sim_counters.draw_calls;
+  if( ctx->fill == GColorClear )
+  {
+    return;
+  }
+
+  for( y = 0; y < rect.size.h; ++y )
+  {
+    for( x = 0; x < rect.size.w; ++x )
+    {
+      _put( ctx, rect.origin.x + x, rect.origin.y + y, ctx->fill );
+    }
+  }
+}
+
+// the source is bitmap->bounds, tiled over rect
+void graphics_draw_bitmap_in_rect( GContext *ctx, const GBitmap *bitmap, GRect rect )
+{
+  int x, y;
+
+  ++sim_counters.draw_calls;
+  if( bitmap == NULL || bitmap->bounds.size.w <= 0 || bitmap->bounds.size.h <= 0 )
+  {
+    return;
+  }
+
+  for( y = 0; y < rect.size.h; ++y )
+  {
+    for( x = 0; x < rect.size.w; ++x )
+    {
+      int dx = rect.origin.x + x, dy = rect.origin.y + y;
+
+      if( _visible( ctx, dx, dy ) )
+      {
+        uint8_t src = _bit( bitmap->addr, bitmap->row_size_bytes,
+                            bitmap->bounds.origin.x + x % bitmap->bounds.size.w,
+                            bitmap->bounds.origin.y + y % bitmap->bounds.size.h );
+        _put( ctx, dx, dy, _composite( ctx->op, src, _get( ctx, dx, dy ) ) );
+      }
+    }
+  }
+}
+
+//
+// Text: one line, no wrapping, cut off at the box
+//
+
+static uint32_t _next_codepoint( const char **text )
+{
+  const uint8_t *s = (const uint8_t*)*text;
+  uint32_t code = *s++;
+  int extra = 0;
+
+  if( code >= 0xf0 )      { code &= 0x07; extra = 3; }
+  else if( code >= 0xe0 ) { code &= 0x0f; extra = 2; }
+  else if( code >= 0xc0 ) { code &= 0x1f; extra = 1; }
+
+  while( extra-- > 0 && ( *s & 0xc0 ) == 0x80 )
+  {
+    code = ( code << 6 ) | ( *s++ & 0x3f );
+  }
+  *text = (const char*)s;
+  return code;
+}
+
+static const SimGlyph* _glyph( GFont font, uint32_t code )
+{
+  int lo = 0, hi = font->glyph_count - 1;
+
+  while( lo <= hi )
+  {
+    int mid = ( lo + hi ) / 2;
+
+    if( font->glyphs[mid].codepoint == code )
+    {
+      return &font->glyphs[mid];
+    }
+    if( font->glyphs[mid].codepoint < code )
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+  return NULL;
+}
+
+static int16_t _text_width( const char *text, GFont font )
+{
+  int16_t width = 0;
+
+  while( text && *text )
+  {
+    const SimGlyph *glyph = _glyph( font, _next_codepoint( &text ) );
+
+    if( glyph )
+    {
+      width += glyph->advance;
+    }
+  }
+  return width;
+}
+
+void graphics_draw_text( GContext *ctx, const char *text, GFont font, GRect box,
+                         GTextOverflowMode overflow_mode, GTextAlignment alignment,
+                         GTextLayoutCacheRef layout )
+{
+  GContext boxed = *ctx;
+  int16_t x = box.origin.x;
+
+  ++sim_counters.draw_calls;
+  if( text == NULL || font == NULL || ctx->text == GColorClear )
+  {
+    return;
+  }
+
+  if( alignment != GTextAlignmentLeft )
+  {
+    int16_t room = box.size.w - _text_width( text, font );
+    x += ( alignment == GTextAlignmentCenter ) ? room / 2 : room;
+  }
+
+  boxed.clip = _intersect( ctx->clip, GRect( box.origin.x + ctx->offset.x, box.origin.y + ctx->offset.y,
+                                             box.size.w, box.size.h ) );
+
+  while( *text )
+  {
+    const SimGlyph *glyph = _glyph( font, _next_codepoint( &text ) );
+    int gx, gy;
+
+    if( glyph == NULL )
+    {
+      continue;
+    }
+
+    for( gy = 0; gy < glyph->h; ++gy )
+    {
+      for( gx = 0; gx < glyph->w; ++gx )
+      {
+        if( _bit( font->bits + glyph->offset, ( glyph->w + 7 ) / 8, gx, gy ) )
+        {
+          _put( &boxed, x + glyph->left + gx, box.origin.y + glyph->top + gy, ctx->text );
+        }
+      }
+    }
+    x += glyph->advance;
+  }
+}
+
+GSize graphics_text_layout_get_content_size( const char *text, GFont font, GRect box,
+                                             GTextOverflowMode overflow_mode,
+                                             GTextAlignment alignment )
+{
+  int16_t width = _text_width( text, font );
+
+  return GSize( width < box.size.w ? width : box.size.w, font->line_height );
+}
+
+//
+// Resources, fonts, bitmaps
+//
+
+ResHandle resource_get_handle( uint32_t resource_id )
+{
+  if( resource_id == 0 || resource_id >= SIM_RESOURCE_COUNT )
+  {
+    return NULL;
+  }
+  return (ResHandle)&SIM_RESOURCES[resource_id];
+}
+
+GFont fonts_get_system_font( const char *font_key )
+{
+  const SimSystemFont *system;
+
+  for( system = SIM_SYSTEM_FONTS; system->key; ++system )
+  {
+    if( strcmp( system->key, font_key ) == 0 )
+    {
+      return (GFont)system->font;
+    }
+  }
+
+  fprintf( stderr, "sim: no stand-in for system font %s\n", font_key );
+  abort();
+}
+
+static size_t _font_bytes( const SimFont *font )
+{
+  const SimGlyph *last = &font->glyphs[font->glyph_count - 1];
+  return font->glyph_count * sizeof( SimGlyph ) + last->offset + ( last->w + 7 ) / 8 * last->h;
+}
+
+// like on the watch the loaded font takes heap: header, glyph table and bits
+GFont fonts_load_custom_font( ResHandle handle )
+{
+  const SimResource *resource = handle;
+  SimFont *font;
+
+  if( resource == NULL || resource->font == NULL )
+  {
+    return NULL;
+  }
+  if( ( font = malloc( sizeof( SimFont ) + _font_bytes( resource->font ) ) ) == NULL )
+  {
+    return NULL;
+  }
+  *font = *resource->font;
+  return font;
+}
+
+void fonts_unload_custom_font( GFont font )
+{
+  free( (void*)font );
+}
+
+GBitmap* gbitmap_create_with_resource( uint32_t resource_id )
+{
+  const SimImage *image;
+  GBitmap *bitmap;
+
+  if( resource_id == 0 || resource_id >= SIM_RESOURCE_COUNT || !( image = SIM_RESOURCES[resource_id].image ) )
+  {
+    return NULL;
+  }
+  if( ( bitmap = malloc( sizeof( GBitmap ) + image->row_size_bytes * image->h ) ) == NULL )
+  {
+    return NULL;
+  }
+
+  *bitmap = (GBitmap){
+    .addr = bitmap + 1,
+    .row_size_bytes = image->row_size_bytes,
+    .info_flags = 0x1000 | BITMAP_HEAP_ALLOCATED,
+    .bounds = GRect( 0, 0, image->w, image->h )
+  };
+  memcpy( bitmap->addr, image->bits, image->row_size_bytes * image->h );
+  return bitmap;
+}
+
+GBitmap* gbitmap_create_as_sub_bitmap( const GBitmap *base_bitmap, GRect sub_rect )
+{
+  GBitmap *bitmap = malloc( sizeof( GBitmap ) );
+
+  if( bitmap )
+  {
+    *bitmap = *base_bitmap;
+    bitmap->info_flags &= ~BITMAP_HEAP_ALLOCATED;
+    bitmap->bounds = _intersect( base_bitmap->bounds, sub_rect );
+  }
+  return bitmap;
+}
+
+void gbitmap_destroy( GBitmap *bitmap )
+{
+  free( bitmap );
+}
+
+//
+// Layers
+//
+
+Layer* layer_create( GRect frame )
+{
+  return layer_create_with_data( frame, 0 );
+}
+
+Layer* layer_create_with_data( GRect frame, size_t data_size )
+{
+  Layer *layer = calloc( 1, sizeof( Layer ) + data_size );
+
+  if( layer )
+  {
+    layer->frame = frame;
+    layer->bounds = GRect( 0, 0, frame.size.w, frame.size.h );
+    layer->clips = true;
+  }
+  return layer;
+}
+
+void layer_destroy( Layer *layer )
+{
+  if( layer )
+  {
+    layer_remove_from_parent( layer );
+    free( layer );
+  }
+}
+
+void* layer_get_data( const Layer *layer )
+{
+  return (void*)layer->data;
+}
+
+void layer_set_update_proc( Layer *layer, LayerUpdateProc update_proc )
+{
+  layer->update_proc = update_proc;
+}
+
+void layer_mark_dirty( Layer *layer )
+{
+  dirty = true;
+}
+
+void layer_set_frame( Layer *layer, GRect frame )
+{
+  if( memcmp( &layer->frame, &frame, sizeof( frame ) ) == 0 )
+  {
+    return;
+  }
+  layer->frame = frame;
+  layer->bounds.size = frame.size;
+  dirty = true;
+}
+
+GRect layer_get_frame( const Layer *layer )
+{
+  return layer->frame;
+}
+
+void layer_set_bounds( Layer *layer, GRect bounds )
+{
+  layer->bounds = bounds;
+  dirty = true;
+}
+
+GRect layer_get_bounds( const Layer *layer )
+{
+  return layer->bounds;
+}
+
+void layer_set_hidden( Layer *layer, bool hidden )
+{
+  if( layer->hidden != hidden )
+  {
+    layer->hidden = hidden;
+    dirty = true;
+  }
+}
+
+bool layer_get_hidden( const Layer *layer )
+{
+  return layer->hidden;
+}
+
+void layer_set_clips( Layer *layer, bool clips )
+{
+  layer->clips = clips;
+  dirty = true;
+}
+
+void layer_add_child( Layer *parent, Layer *child )
+{
+  Layer **last = &parent->first_child;
+
+  layer_remove_from_parent( child );
+  while( *last )
+  {
+    last = &( *last )->next_sibling;
+  }
+  *last = child;
+  child->parent = parent;
+  dirty = true;
+}
+
+void layer_remove_from_parent( Layer *child )
+{
+  Layer **link;
+
+  if( child->parent == NULL )
+  {
+    return;
+  }
+  for( link = &child->parent->first_child; *link; link = &( *link )->next_sibling )
+  {
+    if( *link == child )
+    {
+      *link = child->next_sibling;
+      break;
+    }
+  }
+  child->parent = NULL;
+  child->next_sibling = NULL;
+  dirty = true;
+}
+
+InverterLayer* inverter_layer_create( GRect frame )
+{
+  InverterLayer *inverter = malloc( sizeof( InverterLayer ) );
+
+  if( inverter == NULL )
+  {
+    return NULL;
+  }
+  if( ( inverter->layer = layer_create( frame ) ) == NULL )
+  {
+    free( inverter );
+    return NULL;
+  }
+  inverter->layer->inverter = true;
+  return inverter;
+}
+
+void inverter_layer_destroy( InverterLayer *inverter_layer )
+{
+  if( inverter_layer )
+  {
+    layer_destroy( inverter_layer->layer );
+    free( inverter_layer );
+  }
+}
+
+Layer* inverter_layer_get_layer( InverterLayer *inverter_layer )
+{
+  return inverter_layer->layer;
+}
+
+//
+// Windows
+//
+
+Window* window_create( void )
+{
+  Window *window = calloc( 1, sizeof( Window ) );
+
+  if( window )
+  {
+    window->root = layer_create( GRect( 0, 0, SIM_SCREEN_WIDTH, SIM_SCREEN_HEIGHT ) );
+    window->root->window = window;
+    window->background = GColorWhite;
+  }
+  return window;
+}
+
+void window_destroy( Window *window )
+{
+  if( window == NULL )
+  {
+    return;
+  }
+  if( window->loaded && window->handlers.unload )
+  {
+    window->handlers.unload( window );
+  }
+  if( top_window == window )
+  {
+    top_window = NULL;
+  }
+  layer_destroy( window->root );
+  free( window );
+}
+
+void window_set_window_handlers( Window *window, WindowHandlers handlers )
+{
+  window->handlers = handlers;
+}
+
+// without fullscreen the status bar takes the top 16 pixels
+void window_set_fullscreen( Window *window, bool enabled )
+{
+  window->fullscreen = enabled;
+  layer_set_frame( window->root, enabled ? GRect( 0, 0, SIM_SCREEN_WIDTH, SIM_SCREEN_HEIGHT )
+                                         : GRect( 0, 16, SIM_SCREEN_WIDTH, SIM_SCREEN_HEIGHT - 16 ) );
+}
+
+void window_set_background_color( Window *window, GColor background_color )
+{
+  window->background = background_color;
+  dirty = true;
+}
+
+Layer* window_get_root_layer( const Window *window )
+{
+  return window->root;
+}
+
+void window_stack_push( Window *window, bool animated )
+{
+  top_window = window;
+  if( !window->loaded )
+  {
+    window->loaded = true;
+    if( window->handlers.load )
+    {
+      window->handlers.load( window );
+    }
+  }
+  if( window->handlers.appear )
+  {
+    window->handlers.appear( window );
+  }
+  dirty = true;
+}
+
+//
+// Render pass
+//
+
+static void _render_layer( Layer *layer, GPoint origin, GRect clip )
+{
+  Layer *child;
+  GRect frame;
+
+  if( layer->hidden )
+  {
+    return;
+  }
+
+  origin.x += layer->frame.origin.x;
+  origin.y += layer->frame.origin.y;
+  frame = GRect( origin.x, origin.y, layer->frame.size.w, layer->frame.size.h );
+  if( layer->clips )
+  {
+    clip = _intersect( clip, frame );
+  }
+
+  if( layer->inverter )
+  {
+    GRect area = _intersect( clip, frame );
+    int x, y;
+
+    ++sim_counters.layer_draws;
+    for( y = area.origin.y; y < area.origin.y + area.size.h; ++y )
+    {
+      for( x = area.origin.x; x < area.origin.x + area.size.w; ++x )
+      {
+        framebuffer[y][x] = !framebuffer[y][x];
+        ++sim_counters.pixels_touched;
+      }
+    }
+  }
+  else if( layer->update_proc )
+  {
+    GContext ctx = {
+      .offset = { origin.x + layer->bounds.origin.x, origin.y + layer->bounds.origin.y },
+      .clip = clip,
+      .stroke = GColorBlack,
+      .fill = GColorBlack,
+      .text = GColorBlack,
+      .op = GCompOpAssign
+    };
+
+    ++sim_counters.layer_draws;
+    layer->update_proc( layer, &ctx );
+  }
+
+  // children are placed relative to the bounds
+  origin.x += layer->bounds.origin.x;
+  origin.y += layer->bounds.origin.y;
+  for( child = layer->first_child; child; child = child->next_sibling )
+  {
+    _render_layer( child, origin, clip );
+  }
+}
+
+void sim_notification( void )
+{
+  // the whole tree is drawn on every pass anyway
+  dirty = true;
+  sim_render();
+}
+
+void sim_render( void )
+{
+  int x, y;
+
+  if( !dirty || top_window == NULL )
+  {
+    return;
+  }
+  dirty = false;
+
+  memcpy( previous, framebuffer, sizeof( framebuffer ) );
+  memset( framebuffer, top_window->background == GColorWhite ? GColorWhite : GColorBlack,
+          sizeof( framebuffer ) );
+  _render_layer( top_window->root, GPointZero,
+                 GRect( 0, 0, SIM_SCREEN_WIDTH, SIM_SCREEN_HEIGHT ) );
+
+  ++sim_counters.frames;
+  for( y = 0; y < SIM_SCREEN_HEIGHT; ++y )
+  {
+    for( x = 0; x < SIM_SCREEN_WIDTH; ++x )
+    {
+      sim_counters.pixels_changed += framebuffer[y][x] != previous[y][x];
+    }
+  }
+
+  if( observer )
+  {
+    observer();
+  }
+}
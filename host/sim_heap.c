@@ -0,0 +1,178 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim_heap.c, created 2026-10-19 / */
+
+#include "sim_internal.h"
+
+// First-fit arena like the app heap on the watch: every block carries a
+// header, free neighbours are merged. Block sizes are host sizes (pointers
+// are 8 bytes here, 4 on the watch), so absolute numbers run high; the
+// shape over time and the fragmentation are what the harnesses look at.
+
+#define ALIGN 8
+
+typedef struct
+{
+  uint32_t size;                // block size including this header
+  uint32_t used;
+} BlockHeader;
+
+#define HEADER_SIZE ( ( sizeof( BlockHeader ) + ALIGN - 1 ) & ~( ALIGN - 1 ) )
+
+static uint8_t arena[SIM_HEAP_SIZE] __attribute__((aligned( ALIGN )));
+static SimHeapInfo info;
+
+static BlockHeader* _block( uint32_t offset )
+{
+  return (BlockHeader*)( arena + offset );
+}
+
+void sim_heap_reset( void )
+{
+  memset( &info, 0, sizeof( info ) );
+  *_block( 0 ) = (BlockHeader){ .size = SIM_HEAP_SIZE, .used = 0 };
+}
+
+void* sim_malloc( size_t size )
+{
+  uint32_t need = (uint32_t)( ( size + HEADER_SIZE + ALIGN - 1 ) & ~( ALIGN - 1 ) );
+  uint32_t at;
+
+  for( at = 0; at < SIM_HEAP_SIZE; at += _block( at )->size )
+  {
+    BlockHeader *block = _block( at );
+
+    if( block->used || block->size < need )
+    {
+      continue;
+    }
+
+    // split unless the rest could not hold a block of its own
+    if( block->size - need >= HEADER_SIZE + ALIGN )
+    {
+      *_block( at + need ) = (BlockHeader){ .size = block->size - need, .used = 0 };
+      block->size = need;
+    }
+    block->used = 1;
+
+    info.used += block->size;
+    info.peak = info.used > info.peak ? info.used : info.peak;
+    ++info.live;
+    ++info.allocs;
+    return arena + at + HEADER_SIZE;
+  }
+
+  ++info.failed;
+  return NULL;
+}
+
+void* sim_calloc( size_t count, size_t size )
+{
+  void *ptr = sim_malloc( count * size );
+
+  if( ptr )
+  {
+    memset( ptr, 0, count * size );
+  }
+  return ptr;
+}
+
+void sim_free( void *ptr )
+{
+  uint32_t at, prev = SIM_HEAP_SIZE;
+
+  if( ptr == NULL )
+  {
+    return;
+  }
+  if( (uint8_t*)ptr < arena + HEADER_SIZE || (uint8_t*)ptr >= arena + SIM_HEAP_SIZE )
+  {
+    fprintf( stderr, "sim: free() of a pointer outside the heap\n" );
+    abort();
+  }
+
+  for( at = 0; at < SIM_HEAP_SIZE; prev = at, at += _block( at )->size )
+  {
+    BlockHeader *block = _block( at );
+
+    if( arena + at + HEADER_SIZE != (uint8_t*)ptr )
+    {
+      continue;
+    }
+    if( !block->used )
+    {
+      fprintf( stderr, "sim: double free()\n" );
+      abort();
+    }
+
+    block->used = 0;
+    info.used -= block->size;
+    --info.live;
+
+    // merge with the free neighbours
+    if( at + block->size < SIM_HEAP_SIZE && !_block( at + block->size )->used )
+    {
+      block->size += _block( at + block->size )->size;
+    }
+    if( prev < SIM_HEAP_SIZE && !_block( prev )->used )
+    {
+      _block( prev )->size += block->size;
+    }
+    return;
+  }
+
+  fprintf( stderr, "sim: free() of a pointer that was not allocated\n" );
+  abort();
+}
+
+size_t heap_bytes_used( void )
+{
+  return info.used;
+}
+
+size_t heap_bytes_free( void )
+{
+  return SIM_HEAP_SIZE - info.used;
+}
+
+SimHeapInfo sim_heap_info( void )
+{
+  SimHeapInfo result = info;
+  uint32_t at;
+
+  result.free_bytes = SIM_HEAP_SIZE - info.used;
+  for( at = 0; at < SIM_HEAP_SIZE; at += _block( at )->size )
+  {
+    BlockHeader *block = _block( at );
+
+    if( !block->used && block->size - HEADER_SIZE > result.largest_free )
+    {
+      result.largest_free = block->size - HEADER_SIZE;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,97 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim_internal.h, created 2026-10-19 / */
+
+#ifndef __SIM_INTERNAL_H
+#define __SIM_INTERNAL_H
+
+// Shared between the simulator's own files, not for harnesses.
+
+#include "sim.h"
+
+// generated by resources.py: glyph bitmaps are packed like GBitmap rows,
+// top is relative to the top of the line
+typedef struct
+{
+  uint32_t codepoint;
+  int16_t  advance;
+  int16_t  left;
+  int16_t  top;
+  uint16_t w, h;
+  uint32_t offset;              // into SimFont.bits
+} SimGlyph;
+
+typedef struct SimFont
+{
+  uint16_t        line_height;
+  uint16_t        ascent;
+  uint16_t        glyph_count;  // sorted by codepoint
+  const SimGlyph *glyphs;
+  const uint8_t  *bits;
+} SimFont;
+
+typedef struct
+{
+  uint16_t       w, h;
+  uint16_t       row_size_bytes;
+  const uint8_t *bits;
+} SimImage;
+
+typedef struct
+{
+  const SimImage *image;
+  const SimFont  *font;
+} SimResource;
+
+typedef struct
+{
+  const char    *key;
+  const SimFont *font;
+} SimSystemFont;
+
+extern const SimResource SIM_RESOURCES[];
+extern const uint32_t SIM_RESOURCE_COUNT;
+extern const SimSystemFont SIM_SYSTEM_FONTS[];
+
+extern SimStats sim_counters;
+
+void sim_heap_reset( void );
+
+void sim_graphics_reset( void );
+void sim_render( void );                // renders if a layer is dirty
+
+void sim_animation_reset( void );
+int64_t sim_animation_next_frame( void );  // -1: nothing scheduled
+void sim_animation_frame( void );
+
+void sim_message_reset( void );
+void sim_message_connected( bool connected );
+
+// runs fn later as an event of the loop, like a timer without a handle
+void sim_post( uint32_t delay_ms, AppTimerCallback callback, void *data );
+
+#endif
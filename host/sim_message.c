@@ -0,0 +1,348 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sim_message.c, created 2026-10-19 / */
+
+#include "sim_internal.h"
+
+// Dictionaries in the SDK's wire layout (a count byte, then packed tuples)
+// and an AppMessage link: the outbox is busy until the ack arrives
+// SIM_MESSAGE_LATENCY_MS later, without bluetooth sending fails.
+
+#define BUFFER_SIZE 1024
+
+struct Dictionary
+{
+  uint8_t count;
+  Tuple   head[];
+} __attribute__((__packed__));
+
+static AppMessageInboxReceived inbox_received = NULL;
+static AppMessageInboxDropped inbox_dropped = NULL;
+static AppMessageOutboxSent outbox_sent = NULL;
+static AppMessageOutboxFailed outbox_failed = NULL;
+static void *context = NULL;
+
+static uint32_t inbox_size = 0, outbox_size = 0;
+static bool connected = true;
+static bool outbox_pending = false;
+static SimPhone phone = NULL;
+
+static uint8_t outbox_buffer[BUFFER_SIZE];
+static DictionaryIterator outbox;
+static uint8_t inbox_buffer[BUFFER_SIZE];
+static DictionaryIterator inbox;
+
+void sim_message_reset( void )
+{
+  inbox_received = NULL;
+  inbox_dropped = NULL;
+  outbox_sent = NULL;
+  outbox_failed = NULL;
+  context = NULL;
+  inbox_size = outbox_size = 0;
+  connected = true;
+  outbox_pending = false;
+  phone = NULL;
+}
+
+void sim_message_connected( bool is_connected )
+{
+  connected = is_connected;
+}
+
+void sim_set_phone( SimPhone handler )
+{
+  phone = handler;
+}
+
+//
+// Dictionaries
+//
+
+DictionaryResult dict_write_begin( DictionaryIterator *iter, uint8_t *buffer, const uint16_t size )
+{
+  if( iter == NULL || buffer == NULL || size < 1 )
+  {
+    return DICT_INVALID_ARGS;
+  }
+  iter->dictionary = (Dictionary*)buffer;
+  iter->dictionary->count = 0;
+  iter->cursor = iter->dictionary->head;
+  iter->end = buffer + size;
+  return DICT_OK;
+}
+
+static DictionaryResult _write( DictionaryIterator *iter, const uint32_t key, TupleType type,
+                                const void *data, const uint16_t size )
+{
+  Tuple *tuple = iter->cursor;
+
+  if( (uint8_t*)tuple + sizeof( Tuple ) + size > (const uint8_t*)iter->end )
+  {
+    return DICT_NOT_ENOUGH_STORAGE;
+  }
+
+  tuple->key = key;
+  tuple->type = type;
+  tuple->length = size;
+  memcpy( tuple->value->data, data, size );
+
+  iter->cursor = (Tuple*)( (uint8_t*)tuple + sizeof( Tuple ) + size );
+  ++iter->dictionary->count;
+  return DICT_OK;
+}
+
+DictionaryResult dict_write_data( DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size )
+{
+  return _write( iter, key, TUPLE_BYTE_ARRAY, data, size );
+}
+
+DictionaryResult dict_write_cstring( DictionaryIterator *iter, const uint32_t key, const char *cstring )
+{
+  return _write( iter, key, TUPLE_CSTRING, cstring, cstring ? strlen( cstring ) + 1 : 0 );
+}
+
+DictionaryResult dict_write_uint8( DictionaryIterator *iter, const uint32_t key, const uint8_t value )
+{
+  return _write( iter, key, TUPLE_UINT, &value, sizeof( value ) );
+}
+
+DictionaryResult dict_write_uint16( DictionaryIterator *iter, const uint32_t key, const uint16_t value )
+{
+  return _write( iter, key, TUPLE_UINT, &value, sizeof( value ) );
+}
+
+DictionaryResult dict_write_uint32( DictionaryIterator *iter, const uint32_t key, const uint32_t value )
+{
+  return _write( iter, key, TUPLE_UINT, &value, sizeof( value ) );
+}
+
+uint32_t dict_write_end( DictionaryIterator *iter )
+{
+  iter->end = iter->cursor;
+  return dict_size( iter );
+}
+
+uint32_t dict_size( DictionaryIterator *iter )
+{
+  return (uint32_t)( (const uint8_t*)iter->end - (const uint8_t*)iter->dictionary );
+}
+
+Tuple* dict_read_begin_from_buffer( DictionaryIterator *iter, const uint8_t *buffer, const uint16_t size )
+{
+  iter->dictionary = (Dictionary*)buffer;
+  iter->end = buffer + size;
+  return dict_read_first( iter );
+}
+
+Tuple* dict_read_first( DictionaryIterator *iter )
+{
+  iter->cursor = iter->dictionary->head;
+  return ( iter->dictionary->count && (const void*)iter->cursor < iter->end ) ? iter->cursor : NULL;
+}
+
+Tuple* dict_read_next( DictionaryIterator *iter )
+{
+  Tuple *next = (Tuple*)( (uint8_t*)iter->cursor + sizeof( Tuple ) + iter->cursor->length );
+
+  if( (const void*)next >= iter->end )
+  {
+    return NULL;
+  }
+  return iter->cursor = next;
+}
+
+Tuple* dict_find( const DictionaryIterator *iter, const uint32_t key )
+{
+  DictionaryIterator it = *iter;
+  Tuple *tuple;
+
+  for( tuple = dict_read_first( &it ); tuple; tuple = dict_read_next( &it ) )
+  {
+    if( tuple->key == key )
+    {
+      return tuple;
+    }
+  }
+  return NULL;
+}
+
+//
+// AppMessage
+//
+
+AppMessageResult app_message_open( const uint32_t size_inbound, const uint32_t size_outbound )
+{
+  if( size_inbound > BUFFER_SIZE || size_outbound > BUFFER_SIZE )
+  {
+    return APP_MSG_OUT_OF_MEMORY;
+  }
+  inbox_size = size_inbound;
+  outbox_size = size_outbound;
+  return APP_MSG_OK;
+}
+
+void app_message_deregister_callbacks( void )
+{
+  inbox_received = NULL;
+  inbox_dropped = NULL;
+  outbox_sent = NULL;
+  outbox_failed = NULL;
+  context = NULL;
+}
+
+void* app_message_set_context( void *ctx )
+{
+  void *old = context;
+  context = ctx;
+  return old;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received( AppMessageInboxReceived received_callback )
+{
+  AppMessageInboxReceived old = inbox_received;
+  inbox_received = received_callback;
+  return old;
+}
+
+AppMessageInboxDropped app_message_register_inbox_dropped( AppMessageInboxDropped dropped_callback )
+{
+  AppMessageInboxDropped old = inbox_dropped;
+  inbox_dropped = dropped_callback;
+  return old;
+}
+
+AppMessageOutboxSent app_message_register_outbox_sent( AppMessageOutboxSent sent_callback )
+{
+  AppMessageOutboxSent old = outbox_sent;
+  outbox_sent = sent_callback;
+  return old;
+}
+
+AppMessageOutboxFailed app_message_register_outbox_failed( AppMessageOutboxFailed failed_callback )
+{
+  AppMessageOutboxFailed old = outbox_failed;
+  outbox_failed = failed_callback;
+  return old;
+}
+
+AppMessageResult app_message_outbox_begin( DictionaryIterator **iterator )
+{
+  if( outbox_size == 0 || iterator == NULL )
+  {
+    return APP_MSG_INVALID_ARGS;
+  }
+  if( outbox_pending )
+  {
+    return APP_MSG_BUSY;
+  }
+
+  dict_write_begin( &outbox, outbox_buffer, outbox_size );
+  *iterator = &outbox;
+  return APP_MSG_OK;
+}
+
+static void _on_ack( void *data )
+{
+  outbox_pending = false;
+
+  if( data == NULL )
+  {
+    if( phone )
+    {
+      DictionaryIterator received;
+      dict_read_begin_from_buffer( &received, outbox_buffer, dict_size( &outbox ) );
+      phone( &received );
+    }
+    if( outbox_sent )
+    {
+      outbox_sent( &outbox, context );
+    }
+  }
+  else if( outbox_failed )
+  {
+    outbox_failed( &outbox, APP_MSG_NOT_CONNECTED, context );
+  }
+}
+
+AppMessageResult app_message_outbox_send( void )
+{
+  if( outbox_pending )
+  {
+    return APP_MSG_BUSY;
+  }
+  if( outbox.end != outbox.cursor )
+  {
+    dict_write_end( &outbox );
+  }
+
+  outbox_pending = true;
+  if( connected )
+  {
+    ++sim_counters.messages_out;
+    sim_counters.message_bytes_out += dict_size( &outbox );
+  }
+  // the failure is reported asynchronously as well, data marks it
+  sim_post( SIM_MESSAGE_LATENCY_MS, _on_ack, connected ? NULL : (void*)&outbox );
+  return APP_MSG_OK;
+}
+
+//
+// Messages from the phone
+//
+
+DictionaryIterator* sim_inbox_begin( void )
+{
+  dict_write_begin( &inbox, inbox_buffer, BUFFER_SIZE );
+  return &inbox;
+}
+
+void sim_inbox_send( void )
+{
+  DictionaryIterator received;
+  uint32_t size = dict_write_end( &inbox );
+
+  if( size > inbox_size )
+  {
+    if( inbox_dropped )
+    {
+      inbox_dropped( APP_MSG_BUFFER_OVERFLOW, context );
+    }
+    return;
+  }
+  if( inbox_received == NULL )
+  {
+    return;
+  }
+
+  ++sim_counters.messages_in;
+  sim_counters.message_bytes_in += size;
+
+  dict_read_begin_from_buffer( &received, inbox_buffer, size );
+  inbox_received( &received, context );
+  sim_render();
+}
@@ -0,0 +1,234 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /soak.c, created 2026-10-19 / */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "sim.h"
+
+#include "../src/settings_record.h"
+
+// Runs the face through <days> simulated days in one life cycle (init,
+// window_load, ticks, deinit) and follows its heap:
+//
+//   soak [<days> [<timeline.csv>]]
+//
+// Minutes pass on the simulated clock, so every animation runs to its end
+// like on the watch. Between the ticks come battery changes, short and
+// long bluetooth drops, taps, settings records from the phone (status bar
+// and inverter several times a day, the fontset once a day) and the
+// phone's telemetry requests. Every simulated hour the heap is sampled into
+// the timeline:
+//
+//   day,hour,used,peak,live,allocs,free,largest,fragmentation
+//
+// allocs counts the allocations in that hour, fragmentation is 1 - largest
+// free block / free bytes. The run fails when an allocation fails, when the
+// lowest use of a day rises GROWTH_DAYS days in a row, or when the heap is
+// not empty after deinit.
+
+#define DAY 1387065600          // Sonntag, 15.12.2013 00:00
+
+#define DEFAULT_DAYS 30
+#define GROWTH_DAYS  3
+#define EVENT_AT_S   20         // events come this far into a minute, the tick's animations are done
+
+// the face's message keys (SETTINGS_* in Filmplakat2.c)
+#define KEY_TELEMETRY 6
+#define KEY_RECORD    7
+
+static uint32_t days = DEFAULT_DAYS;
+static FILE *timeline = NULL;
+
+static SettingsRecord settings;
+
+static struct
+{
+  uint32_t allocs;              // at the last sample
+  uint32_t day_min;             // lowest use of the current day
+  uint32_t last_day_min;
+  uint32_t growth;              // days in a row the minimum rose
+  uint32_t max_used, max_peak;
+  double   max_fragmentation;
+  bool     leaking;
+} heap = { 0, UINT32_MAX, 0, 0, 0, 0, 0.0, false };
+
+static void _send_settings( void )
+{
+  uint8_t data[SETTINGS_RECORD_SIZE];
+  DictionaryIterator *it = sim_inbox_begin();
+
+  settings_record_pack( &settings, data );
+  dict_write_data( it, KEY_RECORD, data, sizeof( data ) );
+  sim_inbox_send();
+}
+
+static void _request_telemetry( void )
+{
+  DictionaryIterator *it = sim_inbox_begin();
+
+  dict_write_uint32( it, KEY_TELEMETRY, 0 );
+  sim_inbox_send();
+}
+
+static void _sample( uint32_t day, uint32_t hour )
+{
+  SimHeapInfo info = sim_heap_info();
+  double fragmentation = info.free_bytes ? 1.0 - (double)info.largest_free / info.free_bytes : 0.0;
+
+  if( timeline )
+  {
+    fprintf( timeline, "%u,%u,%u,%u,%u,%u,%u,%u,%.3f\n", day, hour, info.used, info.peak, info.live,
+             info.allocs - heap.allocs, info.free_bytes, info.largest_free, fragmentation );
+  }
+  heap.allocs = info.allocs;
+  heap.max_used = info.used > heap.max_used ? info.used : heap.max_used;
+  heap.max_peak = info.peak;
+  heap.max_fragmentation = fragmentation > heap.max_fragmentation ? fragmentation : heap.max_fragmentation;
+  heap.day_min = info.used < heap.day_min ? info.used : heap.day_min;
+
+  if( hour == 23 )
+  {
+    heap.growth = ( day > 0 && heap.day_min > heap.last_day_min ) ? heap.growth + 1 : 0;
+    if( heap.growth >= GROWTH_DAYS && !heap.leaking )
+    {
+      printf( "  heap grows: lowest use rose %u days in a row, %u bytes on day %u\n",
+              heap.growth, heap.day_min, day );
+      heap.leaking = true;
+    }
+    heap.last_day_min = heap.day_min;
+    heap.day_min = UINT32_MAX;
+  }
+}
+
+static void _scenario( void )
+{
+  uint32_t minute;
+
+  for( minute = 0; minute < days * 24 * 60; ++minute )
+  {
+    sim_run_to( DAY + minute * 60 + EVENT_AT_S );
+
+    // battery between 30 and 100%, no alarm
+    if( minute % 41 == 0 )
+    {
+      bool charging = ( minute / 328 ) % 2;
+      sim_set_battery( (BatteryChargeState){ 30 + ( minute / 41 % 8 ) * 10, charging, charging } );
+    }
+
+    // short drops are filtered, every tenth one outlasts the alert delay
+    if( minute % 97 == 0 )
+    {
+      sim_set_bluetooth( false );
+      sim_run( ( minute / 97 ) % 10 == 0 ? 10000 : 2000 );
+      sim_set_bluetooth( true );
+    }
+
+    if( minute % 240 == 120 )
+    {
+      sim_tap( ACCEL_AXIS_Y, 1 );
+    }
+
+    if( minute % 360 == 180 )
+    {
+      settings.value[SETTING_STATUS_VISIBLE] ^= 1;
+      _send_settings();
+    }
+    if( minute % 360 == 300 )
+    {
+      settings.value[SETTING_INVERTER_STATE] ^= 1;
+      _send_settings();
+    }
+    if( minute % 1440 == 720 )
+    {
+      settings.value[SETTING_REGULAR_FONTSET] ^= 1;
+      _send_settings();
+    }
+    if( minute % 1440 == 900 )
+    {
+      _request_telemetry();
+    }
+
+    if( minute % 60 == 59 )
+    {
+      sim_run_to( DAY + minute * 60 + 59 );
+      _sample( minute / ( 24 * 60 ), minute / 60 % 24 );
+    }
+  }
+}
+
+int filmplakat_main( void );
+
+int main( int argc, char **argv )
+{
+  SimHeapInfo info;
+  const SimStats *stats;
+  clock_t start = clock();
+
+  if( argc > 1 )
+  {
+    days = strtoul( argv[1], NULL, 0 );
+  }
+  if( argc > 2 )
+  {
+    if( ( timeline = fopen( argv[2], "w" ) ) == NULL )
+    {
+      perror( argv[2] );
+      return 2;
+    }
+    fprintf( timeline, "day,hour,used,peak,live,allocs,free,largest,fragmentation\n" );
+  }
+
+  settings.value[SETTING_INVERTER_STATE]  = SETTING_DEFAULT_INVERTER_STATE;
+  settings.value[SETTING_STATUS_VISIBLE]  = SETTING_DEFAULT_STATUS_VISIBLE;
+  settings.value[SETTING_ACCEL_CONFIG]    = SETTING_DEFAULT_ACCEL_CONFIG;
+  settings.value[SETTING_REGULAR_FONTSET] = SETTING_DEFAULT_REGULAR_FONTSET;
+
+  sim_reset( DAY );
+  sim_set_battery( (BatteryChargeState){ 80, false, false } );
+  sim_set_bluetooth( true );
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+
+  info = sim_heap_info();
+  stats = sim_stats();
+  if( timeline )
+  {
+    fclose( timeline );
+  }
+
+  printf( "%u days in %.1f s: %u ticks, %u animations, %u frames, %u messages in, %u out\n",
+          days, (double)( clock() - start ) / CLOCKS_PER_SEC, stats->ticks, stats->animations,
+          stats->frames, stats->messages_in, stats->messages_out );
+  printf( "heap: %u allocations, %u failed, most used %u, peak %u of %u bytes, fragmentation up to %.0f%%, "
+          "%u blocks (%u bytes) left after deinit\n",
+          info.allocs, info.failed, heap.max_used, info.peak, SIM_HEAP_SIZE,
+          heap.max_fragmentation * 100, info.live, info.used );
+
+  return ( info.failed || heap.leaking || info.live ) ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /stress_movie_text_layer.c, created 2026-10-19 / */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "test.h"
+#include "sim.h"
+
+// the layer data and the frame counter are static
+#include "../src/movie_text_layer.c"
+
+// Randomized stress run for MovieTextLayer on the simulated clock.
+//
+//   stress_movie_text_layer [<operations> [<seed>]]
+//
+// Seeded random set_text / set_origin calls with every update mode go to
+// the five rows, in bursts between which the clock moves zero to three
+// animation frames, so most calls land in running animations (unschedule,
+// retarget, MovieTextUpdateDelay, empty texts). After every call a layer
+// is idle exactly when its animation is not scheduled. After each round
+// every layer has to settle at the last requested text and origin, the
+// heap has to be where it was and every started animation must have
+// stopped. A failing round prints its seed; passed as <seed>, the run
+// starts with that round.
+
+#define DEFAULT_OPERATIONS 2000000
+#define DEFAULT_SEED       0x5EED
+
+#define LAYERS        5
+#define BURST         4       // calls per burst
+#define ROUND_CALLS   200     // calls per round, then settle and check
+#define SETTLE_MS     10000
+#define MAX_REPORTS   10
+
+typedef struct
+{
+  const char *text;           // last requested text
+  GPoint      origin;         // last requested origin
+  bool        origin_pending; // MovieTextUpdateDelay on an idle layer, not applied yet
+} Shadow;
+
+static const char *TEXTS[] = {
+  "", "eins", "zwei", "drei", "zwanzig", "dreiundzwanzig", "uhr", "Mo 24. Dez"
+};
+
+static MovieTextLayer *layers[LAYERS];
+static Shadow shadow[LAYERS];
+
+static uint32_t rng;
+
+// xorshift32
+static uint32_t _random( uint32_t range )
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng % range;
+}
+
+static void _random_call( void )
+{
+  int i = _random( LAYERS );
+  MovieTextUpdateMode mode = _random( MovieTextUpdateDelay + 1 );
+  bool delay = _random( 4 ) == 0;
+
+  if( _random( 5 ) < 3 )
+  {
+    shadow[i].text = TEXTS[_random( ARRAY_LENGTH( TEXTS ) )];
+    shadow[i].origin_pending = false;
+    movie_text_layer_set_text( layers[i], shadow[i].text, mode, delay );
+  }
+  else
+  {
+    GPoint origin = GPoint( (int16_t)_random( 40 ) - 10, (int16_t)_random( 130 ) );
+
+    // a delayed origin on an idle layer waits for the next text change
+    shadow[i].origin_pending = ( mode == MovieTextUpdateDelay &&
+                                 movie_text_layer_get_state( layers[i] ) == MovieTextStateIdle );
+    shadow[i].origin = origin;
+    movie_text_layer_set_origin( layers[i], origin, mode, delay );
+  }
+}
+
+static bool _consistent( void )
+{
+  int i;
+
+  for( i = 0; i < LAYERS; ++i )
+  {
+    MovieTextLayerData *data = (MovieTextLayerData*)layer_get_data( layers[i] );
+
+    if( ( data->state == MovieTextStateIdle ) == animation_is_scheduled( data->animation ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool _settled( void )
+{
+  int i;
+
+  for( i = 0; i < LAYERS; ++i )
+  {
+    GRect frame = layer_get_frame( layers[i] );
+    GPoint origin = movie_textLayer_get_origin( layers[i] );
+
+    if( movie_text_layer_get_state( layers[i] ) != MovieTextStateIdle ||
+        strcmp( movie_text_layer_get_text( layers[i] ), shadow[i].text ) != 0 ||
+        origin.x != shadow[i].origin.x || origin.y != shadow[i].origin.y ||
+        frame.size.w != SCREEN_WIDTH ||
+        ( !shadow[i].origin_pending && ( frame.origin.x != origin.x || frame.origin.y != origin.y ) ) )
+    {
+      fprintf( stderr, "  layer %d: '%s' (%d,%d %dx%d) state %d, want '%s' (%d,%d)\n",
+               i, movie_text_layer_get_text( layers[i] ),
+               frame.origin.x, frame.origin.y, frame.size.w, frame.size.h,
+               movie_text_layer_get_state( layers[i] ),
+               shadow[i].text, shadow[i].origin.x, shadow[i].origin.y );
+      return false;
+    }
+  }
+  return true;
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t operations = argc > 1 ? strtoul( argv[1], NULL, 0 ) : DEFAULT_OPERATIONS;
+  uint32_t done = 0, rounds = 0, bad_rounds = 0;
+  uint32_t animations = 0, interrupted = 0, frames = 0;
+  MovieTextActivity activity;
+  SimHeapInfo heap;
+  clock_t start;
+  int i;
+
+  rng = argc > 2 ? strtoul( argv[2], NULL, 0 ) : DEFAULT_SEED;
+
+  sim_reset( 0 );
+  for( i = 0; i < LAYERS; ++i )
+  {
+    layers[i] = movie_text_layer_create( GPoint( 0, 30 * i ), 40 );
+    shadow[i].text = "";
+    shadow[i].origin = GPoint( 0, 30 * i );
+    shadow[i].origin_pending = false;
+  }
+  heap = sim_heap_info();
+  movie_text_layer_get_activity( NULL, true );
+
+  start = clock();
+  while( done < operations )
+  {
+    uint32_t seed = rng;
+    bool ok = true;
+    int calls;
+
+    for( calls = 0; calls < ROUND_CALLS; ++calls, ++done )
+    {
+      _random_call();
+      ok &= _consistent();
+
+      if( calls % BURST == BURST - 1 )
+      {
+        sim_run( SIM_FRAME_MS * _random( 4 ) );
+        ok &= _consistent();
+      }
+    }
+
+    ok &= sim_settle( SETTLE_MS );
+    ok &= _settled();
+    ok &= running_layers == 0;
+    ok &= sim_heap_info().allocs == heap.allocs && sim_heap_info().used == heap.used;
+
+    // 16 bit counters, collected every round
+    movie_text_layer_get_activity( &activity, true );
+    animations  += activity.animations;
+    interrupted += activity.interrupted;
+    frames      += activity.frames;
+
+    ++rounds;
+    if( !ok && ++bad_rounds <= MAX_REPORTS )
+    {
+      fprintf( stderr, "round %u failed, seed 0x%x\n", rounds, seed );
+    }
+  }
+
+  printf( "%u operations in %u rounds, %.1f s: %u animations (%u cut short), %u frames, %u rounds failed\n",
+          done, rounds, (double)( clock() - start ) / CLOCKS_PER_SEC,
+          animations, interrupted, frames, bad_rounds );
+
+  for( i = 0; i < LAYERS; ++i )
+  {
+    movie_text_layer_destroy( layers[i] );
+  }
+  return ( bad_rounds || sim_heap_info().live ) ? 1 : 0;
+}
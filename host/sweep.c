@@ -0,0 +1,463 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /sweep.c, created 2026-10-19 / */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+#include "../src/settings_record.h"
+
+// Exhaustive state sweep: every minute of a day under every combination of
+// fontset, inverter and status bar, each with every transition into it:
+//
+//   tick       the minute changes, nothing else
+//   status     the status bar is toggled from the phone before the tick
+//   inverter   the same for the inverter
+//   fontset    the same for the fontset
+//   restart    the face starts in the minute
+//
+// Each case is a face of its own, started in the minute before (the face
+// keeps its state in statics), so the cases run in a pool of worker
+// processes, -j of them, one per core by default. A case records the
+// frames, the pixels touched and the animations from the transition on,
+// and a hash of the settled screen. Printed is one line per combination and
+// transition, the hash covers its cases in minute order:
+//
+//   sweep [-j <workers>] [--every <minutes>] [--update] [<golden dir>]
+//
+// --every takes every n-th minute only. With a golden dir the table is
+// compared with <golden dir>/sweep-<every>.txt, --update rewrites it.
+
+#define DAY 1387065600          // Sonntag, 15.12.2013 00:00
+
+#define MINUTES      ( 24 * 60 )
+#define COMBINATIONS 8          // bits: regular fontset, inverter, status bar
+#define TRANSITION_AT_S 50      // into the minute before, the start is settled by then
+#define STARTUP_MS   5000       // startup stages, fontset, rows sliding in
+
+// the face's storage keys (SETTINGS_* in Filmplakat2.c) and message key
+#define KEY_INVERTER 1
+#define KEY_STATUS   2
+#define KEY_REGULAR  4
+#define KEY_RECORD   7
+
+#define HASH_INIT 2166136261u   // FNV-1a
+#define HASH_PRIME 16777619u
+
+typedef enum
+{
+  TRANSITION_TICK = 0,
+  TRANSITION_STATUS,
+  TRANSITION_INVERTER,
+  TRANSITION_FONTSET,
+  TRANSITION_RESTART,
+  TRANSITIONS
+} Transition;
+
+static const char *TRANSITION_NAMES[TRANSITIONS] = { "tick", "status", "inverter", "fontset", "restart" };
+
+typedef struct
+{
+  uint32_t index;               // into the case table
+  uint32_t frames;
+  uint32_t pixels;
+  uint32_t animations;
+  uint32_t hash;
+  uint8_t  unsettled;           // animations still running after 10 s
+  uint8_t  done;
+} CaseResult;
+
+typedef struct
+{
+  uint32_t cases, frames, animations, failed;
+  uint64_t pixels;
+  uint32_t max_pixels;
+  uint16_t minute_of_max;
+  uint32_t hash;
+} Group;
+
+static uint32_t every = 1;
+
+// pebble.h takes malloc() to the simulated heap, the tool keeps to statics
+static CaseResult results[MINUTES * TRANSITIONS * COMBINATIONS];
+static char table[8192], golden[8192];
+
+//
+// One case, in a process of its own
+//
+
+static uint32_t current_index;
+static uint16_t current_minute;
+static uint8_t current_combination;
+static Transition current_transition;
+static CaseResult result;
+static SimStats start;
+
+static uint32_t _hash( uint32_t hash, uint8_t byte )
+{
+  return ( hash ^ byte ) * HASH_PRIME;
+}
+
+static uint32_t _screen_hash( void )
+{
+  uint32_t hash = HASH_INIT;
+  int16_t x, y;
+
+  for( y = 0; y < SIM_SCREEN_HEIGHT; ++y )
+  {
+    for( x = 0; x < SIM_SCREEN_WIDTH; ++x )
+    {
+      hash = _hash( hash, sim_pixel( x, y ) == GColorWhite );
+    }
+  }
+  return hash;
+}
+
+// the face's settings as a record from the phone, one of them toggled
+static void _send_settings( Transition toggle )
+{
+  uint8_t data[SETTINGS_RECORD_SIZE];
+  SettingsRecord settings;
+  DictionaryIterator *it;
+
+  settings.value[SETTING_REGULAR_FONTSET] = ( current_combination & 1 ) ^ ( toggle == TRANSITION_FONTSET );
+  settings.value[SETTING_INVERTER_STATE] = !!( current_combination & 2 ) ^ ( toggle == TRANSITION_INVERTER );
+  settings.value[SETTING_STATUS_VISIBLE] = !!( current_combination & 4 ) ^ ( toggle == TRANSITION_STATUS );
+  settings.value[SETTING_ACCEL_CONFIG] = SETTING_DEFAULT_ACCEL_CONFIG;
+
+  settings_record_pack( &settings, data );
+  it = sim_inbox_begin();
+  dict_write_data( it, KEY_RECORD, data, sizeof( data ) );
+  sim_inbox_send();
+}
+
+static void _scenario( void )
+{
+  int64_t minute_start = DAY + current_minute * 60;
+
+  if( current_transition != TRANSITION_RESTART )
+  {
+    sim_run_to( minute_start - 60 + TRANSITION_AT_S );
+    start = *sim_stats();
+    if( current_transition != TRANSITION_TICK )
+    {
+      _send_settings( current_transition );
+    }
+    sim_run_to( minute_start + 1 );
+  }
+  else
+  {
+    sim_run( STARTUP_MS );
+  }
+
+  result.unsettled = !sim_settle( 10000 );
+  result.frames = sim_stats()->frames - start.frames;
+  result.pixels = sim_stats()->pixels_touched - start.pixels_touched;
+  result.animations = sim_stats()->animations - start.animations;
+  result.hash = _screen_hash();
+  result.done = 1;
+}
+
+int filmplakat_main( void );
+
+static void _run_case( uint32_t index, int fd )
+{
+  current_index = index;
+  current_minute = index % MINUTES;
+  current_transition = ( index / MINUTES ) % TRANSITIONS;
+  current_combination = index / ( MINUTES * TRANSITIONS );
+
+  // restart: the face starts in the minute, the others in the minute before
+  sim_reset( DAY + current_minute * 60 - ( current_transition == TRANSITION_RESTART ? 0 : 60 ) );
+  persist_write_bool( KEY_REGULAR, current_combination & 1 );
+  persist_write_bool( KEY_INVERTER, current_combination & 2 );
+  persist_write_bool( KEY_STATUS, current_combination & 4 );
+  sim_set_battery( (BatteryChargeState){ 80, false, false } );
+  sim_set_bluetooth( true );
+
+  start = *sim_stats();
+  result.index = index;
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+
+  // one write below PIPE_BUF, the workers share the pipe
+  if( write( fd, &result, sizeof( result ) ) != sizeof( result ) )
+  {
+    _exit( 2 );
+  }
+  _exit( 0 );
+}
+
+//
+// The pool
+//
+
+// results of the cases that are done, the pipe never fills up
+static void _drain( int fd )
+{
+  CaseResult r;
+
+  while( read( fd, &r, sizeof( r ) ) == sizeof( r ) )
+  {
+    if( r.index < ARRAY_LENGTH( results ) )
+    {
+      results[r.index] = r;
+    }
+  }
+}
+
+static bool _run_all( uint32_t workers )
+{
+  uint32_t next = 0, running = 0, count = MINUTES * TRANSITIONS * COMBINATIONS;
+  int fds[2], status;
+  pid_t pid;
+
+  if( pipe( fds ) != 0 || fcntl( fds[0], F_SETFL, O_NONBLOCK ) != 0 )
+  {
+    perror( "pipe" );
+    return false;
+  }
+
+  while( next < count || running > 0 )
+  {
+    while( running < workers && next < count )
+    {
+      if( next % MINUTES % every != 0 )
+      {
+        ++next;
+        continue;
+      }
+
+      fflush( stdout );
+      if( ( pid = fork() ) < 0 )
+      {
+        perror( "fork" );
+        return false;
+      }
+      if( pid == 0 )
+      {
+        close( fds[0] );
+        _run_case( next, fds[1] );
+      }
+      ++next;
+      ++running;
+    }
+
+    if( running == 0 )
+    {
+      break;
+    }
+
+    // a crashed case writes nothing and stays not done
+    while( ( pid = waitpid( -1, &status, 0 ) ) < 0 && errno == EINTR )
+    {
+    }
+    --running;
+    _drain( fds[0] );
+  }
+
+  close( fds[1] );
+  _drain( fds[0] );
+  close( fds[0] );
+  return true;
+}
+
+static void _groups( Group groups[COMBINATIONS][TRANSITIONS] )
+{
+  uint32_t index, i;
+
+  memset( groups, 0, sizeof( Group ) * COMBINATIONS * TRANSITIONS );
+  for( index = 0; index < MINUTES * TRANSITIONS * COMBINATIONS; ++index )
+  {
+    const CaseResult *r = &results[index];
+    Group *g = &groups[index / ( MINUTES * TRANSITIONS )][( index / MINUTES ) % TRANSITIONS];
+
+    if( index % MINUTES == 0 )
+    {
+      g->hash = HASH_INIT;
+    }
+    if( index % MINUTES % every != 0 )
+    {
+      continue;
+    }
+
+    ++g->cases;
+    if( !r->done || r->unsettled )
+    {
+      ++g->failed;
+      continue;
+    }
+    g->frames += r->frames;
+    g->pixels += r->pixels;
+    g->animations += r->animations;
+    if( r->pixels > g->max_pixels )
+    {
+      g->max_pixels = r->pixels;
+      g->minute_of_max = index % MINUTES;
+    }
+    for( i = 0; i < 4; ++i )
+    {
+      g->hash = _hash( g->hash, r->hash >> ( i * 8 ) );
+    }
+  }
+}
+
+static void _print( FILE *out, Group groups[COMBINATIONS][TRANSITIONS] )
+{
+  uint32_t total = HASH_INIT;
+  int c, t, i;
+
+  fprintf( out, "%-34s %6s %8s %12s %10s %6s %10s %8s\n", "combination / transition",
+           "cases", "frames", "pixels", "max pixels", "at", "animations", "hash" );
+  for( c = 0; c < COMBINATIONS; ++c )
+  {
+    for( t = 0; t < TRANSITIONS; ++t )
+    {
+      const Group *g = &groups[c][t];
+      char name[40];
+
+      snprintf( name, sizeof( name ), "%s%s%s / %s", c & 1 ? "regular" : "italic",
+                c & 2 ? " inverter" : "", c & 4 ? " status" : "", TRANSITION_NAMES[t] );
+      fprintf( out, "%-34s %6u %8u %12llu %10u %02u:%02u %10u %08x\n", name, g->cases, g->frames,
+               (unsigned long long)g->pixels, g->max_pixels, g->minute_of_max / 60, g->minute_of_max % 60,
+               g->animations, g->hash );
+      for( i = 0; i < 4; ++i )
+      {
+        total = _hash( total, g->hash >> ( i * 8 ) );
+      }
+    }
+  }
+  fprintf( out, "total %08x\n", total );
+}
+
+static bool _compare( const char *path )
+{
+  FILE *f = fopen( path, "r" );
+  size_t size;
+
+  if( f == NULL )
+  {
+    perror( path );
+    return false;
+  }
+  size = fread( golden, 1, sizeof( golden ) - 1, f );
+  golden[size] = '\0';
+  fclose( f );
+  return strcmp( golden, table ) == 0;
+}
+
+int main( int argc, char **argv )
+{
+  uint32_t workers = sysconf( _SC_NPROCESSORS_ONLN ), cases = 0, failed = 0;
+  Group groups[COMBINATIONS][TRANSITIONS];
+  const char *golden_dir = NULL;
+  bool update = false;
+  struct timespec t0, t1;
+  char path[256];
+  FILE *out;
+  int arg, c, t;
+
+  for( arg = 1; arg < argc; ++arg )
+  {
+    if( strcmp( argv[arg], "-j" ) == 0 && arg + 1 < argc )
+    {
+      workers = strtoul( argv[++arg], NULL, 0 );
+    }
+    else if( strcmp( argv[arg], "--every" ) == 0 && arg + 1 < argc )
+    {
+      every = strtoul( argv[++arg], NULL, 0 );
+    }
+    else if( strcmp( argv[arg], "--update" ) == 0 )
+    {
+      update = true;
+    }
+    else if( argv[arg][0] != '-' && golden_dir == NULL )
+    {
+      golden_dir = argv[arg];
+    }
+    else
+    {
+      fprintf( stderr, "usage: %s [-j <workers>] [--every <minutes>] [--update] [<golden dir>]\n", argv[0] );
+      return 2;
+    }
+  }
+  workers = workers ? workers : 1;
+  every = every ? every : 1;
+
+  clock_gettime( CLOCK_MONOTONIC, &t0 );
+  if( !_run_all( workers ) )
+  {
+    return 2;
+  }
+  clock_gettime( CLOCK_MONOTONIC, &t1 );
+
+  _groups( groups );
+
+  out = fmemopen( table, sizeof( table ), "w" );
+  _print( out, groups );
+  fclose( out );
+  fputs( table, stdout );
+
+  for( c = 0; c < COMBINATIONS; ++c )
+  {
+    for( t = 0; t < TRANSITIONS; ++t )
+    {
+      cases += groups[c][t].cases;
+      failed += groups[c][t].failed;
+    }
+  }
+  printf( "%u cases on %u workers in %.1f s, %u failed\n", cases, workers,
+          ( t1.tv_sec - t0.tv_sec ) + ( t1.tv_nsec - t0.tv_nsec ) / 1e9, failed );
+
+  if( golden_dir )
+  {
+    snprintf( path, sizeof( path ), "%s/sweep-%u.txt", golden_dir, every );
+    if( update )
+    {
+      if( ( out = fopen( path, "w" ) ) == NULL )
+      {
+        perror( path );
+        return 2;
+      }
+      fputs( table, out );
+      fclose( out );
+    }
+    else if( !_compare( path ) )
+    {
+      printf( "differs from %s\n", path );
+      ++failed;
+    }
+  }
+
+  return failed ? 1 : 0;
+}
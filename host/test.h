@@ -0,0 +1,66 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test.h, created 2026-10-19 / */
+
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+// Minimal checks for the host tests: CHECK() reports and counts a failure
+// and goes on, test_result() is main()'s exit code.
+
+#include <stdio.h>
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define CHECK( cond ) \
+  do { \
+    ++test_checks; \
+    if( !( cond ) ) \
+    { \
+      ++test_failures; \
+      fprintf( stderr, "%s:%d: CHECK( %s ) failed\n", __FILE__, __LINE__, #cond ); \
+    } \
+  } while( 0 )
+
+#define CHECK_STR( actual, expected ) \
+  do { \
+    ++test_checks; \
+    if( strcmp( ( actual ), ( expected ) ) != 0 ) \
+    { \
+      ++test_failures; \
+      fprintf( stderr, "%s:%d: \"%s\", expected \"%s\"\n", __FILE__, __LINE__, ( actual ), ( expected ) ); \
+    } \
+  } while( 0 )
+
+static int test_result( const char *name )
+{
+  printf( "%s: %d checks, %d failed\n", name, test_checks, test_failures );
+  return test_failures ? 1 : 0;
+}
+
+#endif
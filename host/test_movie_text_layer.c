@@ -0,0 +1,372 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test_movie_text_layer.c, created 2026-10-19 / */
+
+#include "test.h"
+#include "sim.h"
+
+// the transition table and the layer data are static
+#include "../src/movie_text_layer.c"
+
+#define ORIGIN     GPoint( 20, 30 )
+#define NEW_ORIGIN GPoint( 2, 60 )
+
+static MovieTextLayerData* _data( MovieTextLayer *layer )
+{
+  return (MovieTextLayerData*)layer_get_data( layer );
+}
+
+static GPoint _frame_origin( MovieTextLayer *layer )
+{
+  return layer_get_frame( layer ).origin;
+}
+
+static bool _same( GPoint a, GPoint b )
+{
+  return a.x == b.x && a.y == b.y;
+}
+
+// at rest: idle, no animation left, the layer shows its target
+static bool _at_rest( MovieTextLayer *layer, const char *text, GPoint origin )
+{
+  MovieTextLayerData *data = _data( layer );
+
+  return data->state == MovieTextStateIdle && !animation_is_scheduled( data->animation ) &&
+         strcmp( data->text, text ) == 0 && _same( _frame_origin( layer ), origin ) &&
+         layer_get_frame( layer ).size.w == SCREEN_WIDTH;
+}
+
+// run until the state changes, i.e. the running animation is done
+static void _done( MovieTextLayer *layer )
+{
+  MovieTextState state = movie_text_layer_get_state( layer );
+  int frames;
+
+  for( frames = 0; frames < 100 && movie_text_layer_get_state( layer ) == state; ++frames )
+  {
+    sim_run( SIM_FRAME_MS );
+  }
+}
+
+// a fresh layer showing "alt", brought into the given state
+static MovieTextLayer* _layer_in( MovieTextState state )
+{
+  MovieTextLayer *layer;
+
+  sim_reset( 0 );
+  layer = movie_text_layer_create( ORIGIN, 40 );
+  movie_text_layer_set_text( layer, "alt", MovieTextUpdateInstant, false );
+
+  switch( state )
+  {
+    case MovieTextStateSlidingOut:
+      movie_text_layer_set_text( layer, "neu", MovieTextUpdateSlideThrough, false );
+      break;
+    case MovieTextStateSlidingIn:
+      movie_text_layer_set_text( layer, "neu", MovieTextUpdateSlideThrough, false );
+      _done( layer );
+      break;
+    case MovieTextStateMoving:
+      movie_text_layer_set_origin( layer, GPoint( 20, 100 ), MovieTextUpdateSlideThrough, false );
+      break;
+    default:
+      break;
+  }
+  sim_run( SIM_FRAME_MS * 2 );
+
+  CHECK( movie_text_layer_get_state( layer ) == state );
+  return layer;
+}
+
+static void test_table( void )
+{
+  MovieTextState state;
+
+  // Done is dispatched without a NULL check (_animation_stopped)
+  for( state = MovieTextStateIdle; state < MovieTextStateCount; ++state )
+  {
+    CHECK( ( transitions[state][MovieTextEventDone] != NULL ) == ( state != MovieTextStateIdle ) );
+  }
+}
+
+static void test_idle( void )
+{
+  MovieTextLayer *layer;
+
+  layer = _layer_in( MovieTextStateIdle );
+  movie_text_layer_set_text( layer, "neu", MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingOut );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neu", ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  // same text: no slide, nothing to do
+  layer = _layer_in( MovieTextStateIdle );
+  movie_text_layer_set_text( layer, "alt", MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateIdle );
+  movie_text_layer_destroy( layer );
+
+  layer = _layer_in( MovieTextStateIdle );
+  movie_text_layer_set_origin( layer, NEW_ORIGIN, MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateMoving );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "alt", NEW_ORIGIN ) );
+  movie_text_layer_destroy( layer );
+}
+
+static void test_sliding_out( void )
+{
+  MovieTextLayer *layer;
+
+  // a newer text is merged: the running slide goes on, brings the latest
+  layer = _layer_in( MovieTextStateSlidingOut );
+  movie_text_layer_set_text( layer, "neuer", MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingOut );
+  CHECK( sim_stats()->animations_unfinished == 0 );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neuer", ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  // the new origin is picked up by the slide in
+  layer = _layer_in( MovieTextStateSlidingOut );
+  movie_text_layer_set_origin( layer, NEW_ORIGIN, MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingOut );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neu", NEW_ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  layer = _layer_in( MovieTextStateSlidingOut );
+  _done( layer );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingIn );
+  CHECK_STR( movie_text_layer_get_text( layer ), "neu" );
+  movie_text_layer_destroy( layer );
+}
+
+static void test_sliding_in( void )
+{
+  MovieTextLayer *layer;
+
+  // nobody has read the entering text, it is swapped in place
+  layer = _layer_in( MovieTextStateSlidingIn );
+  movie_text_layer_set_text( layer, "neuer", MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingIn );
+  CHECK_STR( _data( layer )->text, "neuer" );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neuer", ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  // the running slide heads for the new origin, no jump at the end
+  layer = _layer_in( MovieTextStateSlidingIn );
+  movie_text_layer_set_origin( layer, NEW_ORIGIN, MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingIn );
+  CHECK( _same( _data( layer )->to.origin, NEW_ORIGIN ) );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neu", NEW_ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  layer = _layer_in( MovieTextStateSlidingIn );
+  _done( layer );
+  CHECK( _at_rest( layer, "neu", ORIGIN ) );
+  movie_text_layer_destroy( layer );
+}
+
+static void test_moving( void )
+{
+  MovieTextLayer *layer;
+
+  layer = _layer_in( MovieTextStateMoving );
+  movie_text_layer_set_text( layer, "neu", MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateSlidingOut );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "neu", GPoint( 20, 100 ) ) );
+  movie_text_layer_destroy( layer );
+
+  // redirected, not restarted
+  layer = _layer_in( MovieTextStateMoving );
+  movie_text_layer_set_origin( layer, NEW_ORIGIN, MovieTextUpdateSlideThrough, false );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateMoving );
+  CHECK( _same( _data( layer )->to.origin, NEW_ORIGIN ) );
+  CHECK( sim_stats()->animations_unfinished == 0 );
+  CHECK( sim_settle( 5000 ) && _at_rest( layer, "alt", NEW_ORIGIN ) );
+  movie_text_layer_destroy( layer );
+
+  layer = _layer_in( MovieTextStateMoving );
+  _done( layer );
+  CHECK( _at_rest( layer, "alt", GPoint( 20, 100 ) ) );
+  movie_text_layer_destroy( layer );
+}
+
+// random requests in every mode at random times: whatever came last is
+// what the layer ends up with
+static void test_random_requests( void )
+{
+  static const char *TEXTS[] = { "fünf", "uhr", "zwanzig", "", "neunzehn", "ein" };
+  uint32_t seed = 26;
+  int round, step;
+
+  for( round = 0; round < 200; ++round )
+  {
+    MovieTextLayer *layer;
+    const char *text = "";
+    GPoint origin = ORIGIN;
+    bool ok;
+
+    sim_reset( 0 );
+    layer = movie_text_layer_create( ORIGIN, 40 );
+
+    for( step = 0; step < 12; ++step )
+    {
+      MovieTextUpdateMode mode;
+
+      seed = seed * 1103515245 + 12345;
+      mode = ( seed >> 8 ) % MovieTextUpdateDelay;
+
+      if( ( seed >> 16 ) & 1 )
+      {
+        text = TEXTS[( seed >> 17 ) % ARRAY_LENGTH( TEXTS )];
+        movie_text_layer_set_text( layer, text, mode, ( seed >> 20 ) & 1 );
+      }
+      else
+      {
+        origin = GPoint( ( seed >> 17 ) % 30, ( seed >> 22 ) % 120 );
+        movie_text_layer_set_origin( layer, origin, mode, ( seed >> 20 ) & 1 );
+      }
+      sim_run( ( seed >> 24 ) % 400 );
+    }
+
+    ok = sim_settle( 10000 ) && _at_rest( layer, text, origin );
+    CHECK( ok );
+    if( !ok )
+    {
+      fprintf( stderr, "  round %d: \"%s\" at %d/%d, expected \"%s\" at %d/%d\n", round,
+               _data( layer )->text, _frame_origin( layer ).x, _frame_origin( layer ).y,
+               text, origin.x, origin.y );
+      break;
+    }
+    movie_text_layer_destroy( layer );
+  }
+}
+
+// Every layer owns one Animation from create to destroy: text and origin
+// changes, in every mode, interrupted or run to the end, must not touch
+// the heap.
+static void test_no_allocations( void )
+{
+  static const char *TEXTS[] = { "fünf", "uhr", "zwanzig", "", "neunzehn" };
+  MovieTextLayer *layer;
+  SimHeapInfo before, after;
+  int mode, i;
+
+  sim_reset( 0 );
+  layer = movie_text_layer_create( ORIGIN, 40 );
+  CHECK( layer != NULL );
+  before = sim_heap_info();
+
+  for( mode = MovieTextUpdateNone; mode <= MovieTextUpdateDelay; ++mode )
+  {
+    for( i = 0; i < (int)ARRAY_LENGTH( TEXTS ); ++i )
+    {
+      movie_text_layer_set_text( layer, TEXTS[i], mode, i & 1 );
+      movie_text_layer_set_origin( layer, GPoint( 20 - i, 30 + 8 * i ), mode, i & 2 );
+
+      // interrupted every other time
+      if( i & 1 )
+      {
+        sim_run( SIM_FRAME_MS * 3 );
+      }
+      else
+      {
+        CHECK( sim_settle( 5000 ) );
+      }
+    }
+  }
+  CHECK( sim_settle( 5000 ) );
+  CHECK( sim_stats()->animations > 0 );
+  CHECK( movie_text_layer_get_state( layer ) == MovieTextStateIdle );
+
+  after = sim_heap_info();
+  CHECK( after.allocs == before.allocs );
+  CHECK( after.used == before.used );
+  CHECK( after.failed == 0 );
+
+  movie_text_layer_destroy( layer );
+  CHECK( sim_heap_info().live == 0 );
+}
+
+// Rows that animate together share their frames: two layers sliding
+// through at once count the frames of one slide (2 x SLIDE_DURATION).
+static void test_activity( void )
+{
+  MovieTextLayer *a, *b;
+  MovieTextActivity activity;
+
+  // every started animation of the tests before was stopped
+  CHECK( running_layers == 0 );
+
+  sim_reset( 0 );
+  a = movie_text_layer_create( ORIGIN, 40 );
+  b = movie_text_layer_create( NEW_ORIGIN, 40 );
+  movie_text_layer_set_text( a, "alt", MovieTextUpdateInstant, false );
+  movie_text_layer_set_text( b, "alt", MovieTextUpdateInstant, false );
+  movie_text_layer_get_activity( NULL, true );
+
+  movie_text_layer_set_text( a, "neu", MovieTextUpdateSlideThrough, false );
+  movie_text_layer_set_text( b, "neu", MovieTextUpdateSlideThrough, false );
+  CHECK( sim_settle( 5000 ) );
+
+  movie_text_layer_get_activity( &activity, true );
+  CHECK( activity.animations == 4 );
+  CHECK( activity.interrupted == 0 );
+  CHECK( activity.frames >= 2 * SLIDE_DURATION / FRAME_INTERVAL - 2 &&
+         activity.frames <= 2 * SLIDE_DURATION / FRAME_INTERVAL + 2 );
+
+  movie_text_layer_destroy( a );
+  movie_text_layer_destroy( b );
+  CHECK( running_layers == 0 );
+}
+
+// the picks the face relies on (EFFECTS_* in Filmplakat2.c)
+static void test_cheapest_effect( void )
+{
+  uint16_t minute = MOVIE_TEXT_EFFECT( MovieTextUpdateWipe ) | MOVIE_TEXT_EFFECT( MovieTextUpdateDissolve );
+
+  CHECK( movie_text_layer_cheapest_effect( 0 ) == MovieTextUpdateInstant );
+  CHECK( movie_text_layer_cheapest_effect( MOVIE_TEXT_EFFECT( MovieTextUpdateSlideThrough ) ) ==
+         MovieTextUpdateSlideThrough );
+  CHECK( movie_text_layer_cheapest_effect( minute ) == MovieTextUpdateWipe );
+  CHECK( movie_text_layer_cheapest_effect( minute | MOVIE_TEXT_EFFECT( MovieTextUpdatePush ) ) ==
+         MovieTextUpdatePush );
+  CHECK( movie_text_layer_cheapest_effect( minute | MOVIE_TEXT_EFFECT( MovieTextUpdateInstant ) ) ==
+         MovieTextUpdateInstant );
+}
+
+int main( void )
+{
+  test_table();
+  test_idle();
+  test_sliding_out();
+  test_sliding_in();
+  test_moving();
+  test_random_requests();
+  test_no_allocations();
+  test_activity();
+  test_cheapest_effect();
+  return test_result( "movie_text_layer" );
+}
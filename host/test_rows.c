@@ -0,0 +1,356 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test_rows.c, created 2026-10-19 / */
+
+#include "test.h"
+#include "sim.h"
+
+// the row pipeline and its state are static; the face's main() is renamed
+// by FACE_CFLAGS, this file brings its own
+#include "../src/Filmplakat2.c"
+#undef main
+
+#define DAY 1387065600          // Sonntag, 15.12.2013 00:00
+
+static struct tm _local( int64_t t )
+{
+  time_t value = t;
+
+  return *localtime( &value );
+}
+
+static TimeUnits _tick_units( const struct tm *t )
+{
+  TimeUnits units = MINUTE_UNIT;
+
+  if( t->tm_min == 0 )
+  {
+    units |= ( t->tm_hour == 0 ) ? ( HOUR_UNIT | DAY_UNIT ) : HOUR_UNIT;
+  }
+  return units;
+}
+
+static void _compose( RowSet *set, int hour, int minute )
+{
+  struct tm t = _local( DAY + hour * 3600 + minute * 60 );
+
+  memset( set, 0, sizeof( *set ) );
+  compose_rows( set, &t, UPDATE_ALL_UNITS );
+}
+
+static bool _same_rows( const RowSet *a, const RowSet *b )
+{
+  int i;
+
+  if( a->cnt != b->cnt )
+  {
+    return false;
+  }
+  for( i = 0; i < NUM_ROWS; ++i )
+  {
+    if( a->key[i] != b->key[i] || strcmp( a->data[i], b->data[i] ) != 0 ||
+        a->pos[i].x != b->pos[i].x || a->pos[i].y != b->pos[i].y )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+// compose_rows(): words and positions
+//
+
+static void test_compose( void )
+{
+  RowSet set;
+  struct tm t;
+
+  settings_regular_fontset = false;
+
+  _compose( &set, 9, 44 );
+  CHECK( set.cnt == 5 );
+  CHECK_STR( set.data[0], "So 15. Dezember" );
+  CHECK_STR( set.data[1], " neun" );
+  CHECK_STR( set.data[2], "uhr" );
+  CHECK_STR( set.data[3], "vıerund" );
+  CHECK_STR( set.data[4], "vıerzıg" );
+  // top to bottom: hour, 'uhr', minutes, date
+  CHECK( set.pos[1].y < set.pos[2].y && set.pos[2].y < set.pos[3].y &&
+         set.pos[3].y < set.pos[4].y && set.pos[4].y < set.pos[0].y );
+  // italic: every row further left than the one above
+  CHECK( set.pos[2].x > set.pos[3].x && set.pos[3].x > set.pos[4].x );
+
+  _compose( &set, 12, 0 );
+  CHECK( set.cnt == 3 );
+  CHECK_STR( set.data[1], " zwölf" );
+  CHECK_STR( set.data[3], "" );
+  CHECK_STR( set.data[4], "" );
+
+  _compose( &set, 17, 1 );
+  CHECK( set.cnt == 4 );
+  CHECK_STR( set.data[3], "eıns" );
+
+  _compose( &set, 0, 20 );
+  CHECK( set.cnt == 4 );
+  CHECK_STR( set.data[1], " null" );
+  CHECK_STR( set.data[3], "zwanzig" );
+
+  _compose( &set, 23, 59 );
+  CHECK_STR( set.data[1], " elf" );
+  CHECK_STR( set.data[3], "neunund" );
+  CHECK_STR( set.data[4], "fünfzig" );
+
+  // fewer rows are centered: the block moves down
+  {
+    RowSet five;
+
+    _compose( &five, 9, 44 );
+    _compose( &set, 9, 0 );
+    CHECK( set.pos[1].y > five.pos[1].y );
+  }
+
+  // only the changed units are rebuilt, the rest is taken from set
+  _compose( &set, 9, 44 );
+  t = _local( DAY + 10 * 3600 + 45 * 60 );
+  compose_rows( &set, &t, MINUTE_UNIT );
+  CHECK_STR( set.data[1], " neun" );
+  CHECK_STR( set.data[3], "fünfund" );
+
+  // rows with the same key keep their text, it is not written again
+  strcpy( set.data[0], "Datum" );
+  strcpy( set.data[1], "Stunde" );
+  t = _local( DAY + 9 * 3600 + 46 * 60 );
+  compose_rows( &set, &t, MINUTE_UNIT );
+  CHECK_STR( set.data[0], "Datum" );
+  CHECK_STR( set.data[1], "Stunde" );
+  CHECK_STR( set.data[3], "sechsund" );
+  t = _local( DAY + 10 * 3600 );
+  compose_rows( &set, &t, MINUTE_UNIT | HOUR_UNIT );
+  CHECK_STR( set.data[0], "Datum" );
+  CHECK_STR( set.data[1], " zehn" );
+
+  settings_regular_fontset = true;
+  _compose( &set, 9, 44 );
+  CHECK( set.pos[0].x == REGULAR_ROW_X && set.pos[2].x == REGULAR_ROW_X &&
+         set.pos[3].x == REGULAR_ROW_X && set.pos[4].x == REGULAR_ROW_X );
+  settings_regular_fontset = false;
+}
+
+//
+// The face for one day: the plan prepared in the pause is what the tick
+// would compute, the tick takes it, and the layers come to rest on it.
+//
+
+// every minute layer is used once, the states fit the words
+static bool _plan_valid( const RowSet *set, const RowPlan plan[NUM_ROWS] )
+{
+  int i, j, uses;
+
+  for( j = FIRST_MINUTE_ROW; j < NUM_ROWS; ++j )
+  {
+    for( uses = 0, i = FIRST_MINUTE_ROW; i < NUM_ROWS; ++i )
+    {
+      uses += plan[i].layer == row[j];
+    }
+    if( uses != 1 )
+    {
+      return false;
+    }
+  }
+
+  for( i = FIRST_MINUTE_ROW; i < NUM_ROWS; ++i )
+  {
+    switch( plan[i].state )
+    {
+      case ROW_STATE_KEEP:
+        if( i < set->cnt ? plan[i].shown != set->key[i] : plan[i].shown != ROW_KEY_EMPTY )
+        {
+          return false;
+        }
+        break;
+
+      case ROW_STATE_MOVE:
+        if( i >= set->cnt || plan[i].shown != set->key[i] )
+        {
+          return false;
+        }
+        break;
+
+      case ROW_STATE_REPLACE:
+      case ROW_STATE_APPEAR:
+        if( i >= set->cnt || plan[i].shown == set->key[i] ||
+            ( plan[i].state == ROW_STATE_APPEAR ) != ( plan[i].shown == ROW_KEY_EMPTY ) )
+        {
+          return false;
+        }
+        break;
+
+      case ROW_STATE_DISAPPEAR:
+        if( i < set->cnt || plan[i].shown == ROW_KEY_EMPTY )
+        {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+// the layers show row_cur: words at their positions, unused rows empty
+static bool _at_rest( void )
+{
+  int i;
+
+  for( i = 0; i < NUM_ROWS; ++i )
+  {
+    const char *text = movie_text_layer_get_text( row[i] );
+    GPoint origin = movie_textLayer_get_origin( row[i] );
+
+    if( movie_text_layer_get_state( row[i] ) != MovieTextStateIdle )
+    {
+      return false;
+    }
+    if( i < row_cur.cnt ? ( strcmp( text, row_cur.data[i] ) != 0 ||
+                            origin.x != row_cur.pos[i].x || origin.y != row_cur.pos[i].y )
+                        : text[0] != '\0' )
+    {
+      fprintf( stderr, "row %d: \"%s\" at %d,%d\n", i, text, origin.x, origin.y );
+      return false;
+    }
+  }
+  return true;
+}
+
+static void _day( void )
+{
+  int minute, prepared = 0, fresh_equal = 0, valid = 0, taken = 0, rest = 0;
+
+  sim_run( 5000 );
+  sim_settle( 10000 );
+  CHECK( _at_rest() );
+
+  for( minute = 1; minute <= 24 * 60; ++minute )
+  {
+    int64_t next = DAY + minute * 60;
+    struct tm t = _local( next );
+    TimeUnits units = _tick_units( &t );
+    RowSet fresh = row_cur;
+    RowPlan plan[NUM_ROWS];
+
+    sim_run_to( next - 1 );
+
+    compose_rows( &fresh, &t, units );
+    plan_minute_rows( &fresh, plan );
+
+    prepared += row_next_prepared && row_next_units == units && row_next_time.tm_min == t.tm_min;
+    fresh_equal += _same_rows( &fresh, &row_next ) && memcmp( plan, row_next_plan, sizeof( plan ) ) == 0;
+    valid += _plan_valid( &row_next, row_next_plan );
+
+    sim_run( 1000 );
+    taken += !row_next_prepared && _same_rows( &fresh, &row_cur );
+
+    sim_settle( 10000 );
+    rest += _at_rest();
+  }
+
+  CHECK( prepared == 24 * 60 );
+  CHECK( fresh_equal == 24 * 60 );
+  CHECK( valid == 24 * 60 );
+  CHECK( taken == 24 * 60 );
+  CHECK( rest == 24 * 60 );
+}
+
+// a fontset change just before the tick lands in the same pass: the
+// prepared plan has the old positions and must not be taken
+static void _fontset_at_tick( void )
+{
+  int64_t next = DAY + ( 24 * 60 + 1 ) * 60;
+  int i;
+
+  sim_run_to( next - 1 );
+  CHECK( row_next_prepared );
+
+  sim_run( 990 );
+  on_setting_received( SETTING_REGULAR_FONTSET, true );
+  sim_run( 1000 );
+  sim_settle( 10000 );
+
+  CHECK( _at_rest() );
+  for( i = 0; i < row_cur.cnt; ++i )
+  {
+    CHECK( i == 1 || row_cur.pos[i].x == REGULAR_ROW_X );
+  }
+}
+
+// the same at 00:00: the tick brings every unit the fontset pass asks
+// for, only the fontset tells the plans apart
+static void _fontset_at_midnight( void )
+{
+  int64_t next = DAY + 2 * 24 * 60 * 60;
+  int i;
+
+  sim_run_to( next - 1 );
+  CHECK( row_next_prepared );
+  CHECK( row_next_units == ( MINUTE_UNIT | HOUR_UNIT | DAY_UNIT ) );
+
+  sim_run( 990 );
+  on_setting_received( SETTING_REGULAR_FONTSET, false );
+  CHECK( !row_next_prepared );
+  sim_run( 1000 );
+  sim_settle( 10000 );
+
+  CHECK( _at_rest() );
+  CHECK_STR( row_cur.data[0], "Di 17. Dezember" );
+  for( i = 2; i < row_cur.cnt; ++i )
+  {
+    CHECK( row_cur.pos[i].x != REGULAR_ROW_X );
+  }
+}
+
+static void _scenario( void )
+{
+  _day();
+  _fontset_at_tick();
+  _fontset_at_midnight();
+}
+
+static void test_day( void )
+{
+  sim_reset( DAY + 30 );
+  sim_set_battery( (BatteryChargeState){ 80, false, false } );
+  sim_set_scenario( _scenario );
+  filmplakat_main();
+}
+
+int main( void )
+{
+  test_compose();
+  test_day();
+
+  return test_result( "rows" );
+}
@@ -0,0 +1,135 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test_settings_record.c, created 2026-10-19 / */
+
+#include "test.h"
+#include "sim.h"
+
+#include "../src/settings_record.h"
+
+// the phone packs the same layout (pebble-js-app.js), so it is spelled
+// out here instead of being derived from the schema
+static void test_layout( void )
+{
+  SettingsRecord record;
+  uint8_t data[SETTINGS_RECORD_SIZE];
+  int f;
+
+  CHECK( SETTING_COUNT == 4 );
+  CHECK( SETTINGS_RECORD_BITS == 4 );
+  CHECK( SETTINGS_RECORD_SIZE == 2 );
+
+  // one field at a time: its bit and nothing else, LSB first in schema order
+  for( f = 0; f < SETTING_COUNT; ++f )
+  {
+    memset( &record, 0, sizeof( record ) );
+    record.value[f] = 1;
+    settings_record_pack( &record, data );
+    CHECK( data[0] == SETTINGS_VERSION );
+    CHECK( data[1] == ( 1 << f ) );
+  }
+
+  // defaults: only the accelerometer is on
+  record.value[SETTING_INVERTER_STATE]  = SETTING_DEFAULT_INVERTER_STATE;
+  record.value[SETTING_STATUS_VISIBLE]  = SETTING_DEFAULT_STATUS_VISIBLE;
+  record.value[SETTING_ACCEL_CONFIG]    = SETTING_DEFAULT_ACCEL_CONFIG;
+  record.value[SETTING_REGULAR_FONTSET] = SETTING_DEFAULT_REGULAR_FONTSET;
+  settings_record_pack( &record, data );
+  CHECK( data[0] == SETTINGS_VERSION && data[1] == 0x04 );
+}
+
+// bits above a field's width are dropped, they don't leak into the next field
+static void test_field_width( void )
+{
+  SettingsRecord record, back;
+  uint8_t data[SETTINGS_RECORD_SIZE];
+
+  memset( &record, 0, sizeof( record ) );
+  record.value[SETTING_INVERTER_STATE] = 0xff;
+  settings_record_pack( &record, data );
+  CHECK( data[1] == 0x01 );
+
+  CHECK( settings_record_unpack( &back, data, sizeof( data ) ) );
+  CHECK( back.value[SETTING_INVERTER_STATE] == 1 );
+  CHECK( back.value[SETTING_STATUS_VISIBLE] == 0 );
+}
+
+static void test_round_trip( void )
+{
+  SettingsRecord record, back;
+  uint8_t data[SETTINGS_RECORD_SIZE];
+  int bits, f;
+
+  for( bits = 0; bits < ( 1 << SETTING_COUNT ); ++bits )
+  {
+    for( f = 0; f < SETTING_COUNT; ++f )
+    {
+      record.value[f] = ( bits >> f ) & 1;
+    }
+    settings_record_pack( &record, data );
+
+    memset( &back, 0xaa, sizeof( back ) );
+    CHECK( settings_record_unpack( &back, data, sizeof( data ) ) );
+    CHECK( memcmp( &record, &back, sizeof( record ) ) == 0 );
+  }
+}
+
+// records of another version or cut short are rejected as a whole, longer
+// ones (fields appended by a newer phone) are read up to what is known
+static void test_reject( void )
+{
+  SettingsRecord record, back;
+  uint8_t data[SETTINGS_RECORD_SIZE + 2];
+  uint16_t length;
+
+  memset( &record, 0, sizeof( record ) );
+  record.value[SETTING_STATUS_VISIBLE] = 1;
+  settings_record_pack( &record, data );
+  data[SETTINGS_RECORD_SIZE] = data[SETTINGS_RECORD_SIZE + 1] = 0xff;
+
+  for( length = 0; length < SETTINGS_RECORD_SIZE; ++length )
+  {
+    CHECK( !settings_record_unpack( &back, data, length ) );
+  }
+
+  CHECK( settings_record_unpack( &back, data, sizeof( data ) ) );
+  CHECK( memcmp( &record, &back, sizeof( record ) ) == 0 );
+
+  data[0] = SETTINGS_VERSION + 1;
+  CHECK( !settings_record_unpack( &back, data, SETTINGS_RECORD_SIZE ) );
+  data[0] = 0;
+  CHECK( !settings_record_unpack( &back, data, SETTINGS_RECORD_SIZE ) );
+}
+
+int main( void )
+{
+  test_layout();
+  test_field_width();
+  test_round_trip();
+  test_reject();
+  return test_result( "settings_record" );
+}
@@ -0,0 +1,138 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test_str_builder.c, created 2026-10-19 / */
+
+#include "test.h"
+#include "sim.h"
+
+#include "../src/str_builder.h"
+
+static void test_fits( void )
+{
+  char buf[8];
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, sizeof( buf ) );
+  CHECK( str_builder_append( &sb, "So" ) );
+  CHECK( str_builder_append_char( &sb, ' ' ) );
+  CHECK( str_builder_append_uint( &sb, 15 ) );
+  CHECK( str_builder_append( &sb, ". " ) );
+  CHECK_STR( buf, "So 15. " );
+  CHECK( sb.len == 7 && !sb.truncated );
+}
+
+static void test_truncates( void )
+{
+  char buf[6];
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, sizeof( buf ) );
+  CHECK( !str_builder_append( &sb, "zwanzig" ) );
+  CHECK_STR( buf, "zwanz" );
+  CHECK( sb.truncated );
+
+  // everything after the first overflow is dropped
+  CHECK( !str_builder_append( &sb, "" ) );
+  CHECK( !str_builder_append_char( &sb, 'x' ) );
+  CHECK_STR( buf, "zwanz" );
+}
+
+static void test_utf8_not_split( void )
+{
+  char buf[5];
+  StrBuilder sb;
+
+  // "fünf": 'ü' is two bytes, only its lead byte would fit
+  str_builder_init( &sb, buf, 3 );
+  CHECK( !str_builder_append( &sb, "fünf" ) );
+  CHECK_STR( buf, "f" );
+
+  // "ı" after "vie": nothing of it fits
+  str_builder_init( &sb, buf, sizeof( buf ) );
+  CHECK( str_builder_append( &sb, "vie" ) );
+  CHECK( !str_builder_append( &sb, "ı" ) );
+  CHECK_STR( buf, "vie" );
+  CHECK( sb.len == 3 );
+}
+
+// a segment starting with a continuation byte must not take back bytes of
+// earlier appends
+static void test_backtrack_bounded( void )
+{
+  char buf[4];
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, sizeof( buf ) );
+  CHECK( str_builder_append( &sb, "abc" ) );
+  CHECK( !str_builder_append( &sb, "\xb1\xb1" ) );
+  CHECK_STR( buf, "abc" );
+  CHECK( sb.len == 3 );
+}
+
+static void test_uint( void )
+{
+  char buf[8];
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, sizeof( buf ) );
+  CHECK( str_builder_append_uint( &sb, 0 ) );
+  CHECK( str_builder_append_char( &sb, ' ' ) );
+  CHECK( str_builder_append_uint( &sb, 65535 ) );
+  CHECK_STR( buf, "0 65535" );
+
+  // the battery label: "100" leaves no room for the '+'
+  str_builder_init( &sb, buf, 4 );
+  CHECK( str_builder_append_uint( &sb, 100 ) );
+  CHECK( !str_builder_append_char( &sb, '+' ) );
+  CHECK_STR( buf, "100" );
+}
+
+static void test_empty_buffer( void )
+{
+  char buf[1] = { 'x' };
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, 0 );
+  CHECK( sb.truncated );
+  CHECK( !str_builder_append( &sb, "a" ) );
+  CHECK( buf[0] == 'x' );
+
+  str_builder_init( &sb, buf, 1 );
+  CHECK( !str_builder_append( &sb, "a" ) );
+  CHECK_STR( buf, "" );
+}
+
+int main( void )
+{
+  test_fits();
+  test_truncates();
+  test_utf8_not_split();
+  test_backtrack_bounded();
+  test_uint();
+  test_empty_buffer();
+  return test_result( "str_builder" );
+}
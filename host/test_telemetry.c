@@ -0,0 +1,137 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /test_telemetry.c, created 2026-10-19 / */
+
+#include "test.h"
+#include "sim.h"
+
+// the ring and the running hour are static
+#include "../src/telemetry.c"
+
+#define DAY  1387065600         // Sonntag, 15.12.2013 00:00
+#define RING 6
+#define HOUR 8
+
+static int64_t _at( int hour, int minute )
+{
+  return DAY + hour * 3600 + minute * 60;
+}
+
+// the face is unloaded for the menu and loaded again
+static void _menu_visit( int64_t back )
+{
+  telemetry_deinit();
+  sim_run_to( back );
+  telemetry_init( RING, HOUR );
+}
+
+static void _hour_tick( int hour )
+{
+  sim_run_to( _at( hour, 0 ) );
+  telemetry_sample( (uint32_t)time( NULL ) );
+}
+
+static void test_hours( void )
+{
+  TelemetrySample *sample;
+
+  sim_reset( _at( 10, 20 ) );
+  sim_set_battery( (BatteryChargeState){ 80, false, false } );
+  telemetry_init( RING, HOUR );
+
+  // the first hour started before the face
+  telemetry_count( TELEMETRY_BT_FLAP );
+  _hour_tick( 11 );
+  CHECK( ring.count == 1 );
+  CHECK( _sample_at( 0 )->flags == TELEMETRY_PARTIAL );
+  CHECK( _sample_at( 0 )->bt_flaps == 1 );
+
+  // menu visits inside the hour neither add samples nor lose counts
+  telemetry_count( TELEMETRY_BT_FLAP );
+  sim_run_to( _at( 11, 10 ) );
+  _menu_visit( _at( 11, 12 ) );
+  telemetry_count( TELEMETRY_BT_FLAP );
+  telemetry_count( TELEMETRY_APP_MESSAGE );
+  sim_run_to( _at( 11, 40 ) );
+  _menu_visit( _at( 11, 41 ) );
+  CHECK( ring.count == 1 );
+
+  sim_set_battery( (BatteryChargeState){ 78, false, false } );
+  telemetry_battery( battery_state_service_peek() );
+  _hour_tick( 12 );
+  CHECK( ring.count == 2 );
+  sample = _sample_at( 1 );
+  CHECK( sample->time == _at( 12, 0 ) );
+  CHECK( sample->flags == 0 );
+  CHECK( sample->bt_flaps == 2 );
+  CHECK( sample->app_messages == 1 );
+  CHECK( sample->charge == 78 );
+
+  // the charger marks the hour it was connected in
+  sim_set_battery( (BatteryChargeState){ 79, true, true } );
+  telemetry_battery( battery_state_service_peek() );
+  _menu_visit( _at( 12, 30 ) );
+  sim_set_battery( (BatteryChargeState){ 90, false, false } );
+  telemetry_battery( battery_state_service_peek() );
+  _hour_tick( 13 );
+  CHECK( _sample_at( 2 )->flags == TELEMETRY_CHARGING );
+
+  // an app ran over the full hour: the hour it was opened in is stored
+  // late and partial, the hour it was closed in is partial too
+  telemetry_count( TELEMETRY_BT_FLAP );
+  sim_run_to( _at( 13, 50 ) );
+  _menu_visit( _at( 15, 10 ) );
+  CHECK( ring.count == 4 );
+  sample = _sample_at( 3 );
+  CHECK( sample->time == _at( 14, 0 ) );
+  CHECK( sample->flags == TELEMETRY_PARTIAL );
+  CHECK( sample->bt_flaps == 1 );
+  CHECK( sample->charge == 90 );
+
+  _hour_tick( 16 );
+  CHECK( ring.count == 5 );
+  CHECK( _sample_at( 4 )->flags == TELEMETRY_PARTIAL );
+  CHECK( _sample_at( 4 )->bt_flaps == 0 );
+
+  // a full hour after that
+  _hour_tick( 17 );
+  CHECK( _sample_at( 5 )->flags == 0 );
+
+  // the ring was stored with each sample, not with each deinit
+  telemetry_deinit();
+  memset( &ring, 0, sizeof( ring ) );
+  telemetry_init( RING, HOUR );
+  CHECK( ring.count == 6 );
+  CHECK( _sample_at( 5 )->time == _at( 17, 0 ) );
+}
+
+int main( void )
+{
+  test_hours();
+
+  return test_result( "telemetry" );
+}
@@ -15,14 +15,21 @@
 
 #include <pebble.h>
 #include "movie_text_layer.h"
+#include "str_builder.h"
+#include "ui_arena.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "msg_session.h"
+#include "settings_record.h"
+#include "stack_probe.h"
+#include "digit_label.h"
 
 #define DEBUG 0
 
+// TRACE / TRACE_ARGS schreiben in den Trace-Ring (siehe trace.h)
 #if DEBUG
-# define TRACE                  APP_LOG( APP_LOG_LEVEL_INFO, __FUNCTION__ );
 # define APP_DBG( msg... )      APP_LOG( APP_LOG_LEVEL_DEBUG, ##msg )
 #else
-# define TRACE
 # define APP_DBG( msg... )
 #endif
 
@@ -49,9 +56,17 @@ static int32_t test_date_pos = 0;
 static AppTimer *test_date_timer = 0;
 #endif
 
+// Start in Stufen (siehe on_startup_step), ein Schritt pro Durchlauf der
+// Ereignisschleife; das erste Bild kommt noch ohne Zeilen
+#define STARTUP_STEP_MS 0
+#define STARTUP_FRAME_TIMEOUT_MS 1000  // ohne erstes Bild (verdeckt) trotzdem weiter
+
 // Gesamtzahl der Zeilen für Uhrzeit
 #define NUM_ROWS 5
 
+// Erste Minutenzeile, alle folgenden Zeilen teilen sich font_minutes
+#define FIRST_MINUTE_ROW 3
+
 
 // Zeilenhöhen in Pixel
 #define BASE_ROW_X 20
@@ -70,23 +85,59 @@ static AppTimer *test_date_timer = 0;
 
 #define ROW_BUF_SIZE 20
 
-// Storage-Keys
+// alle Zeilen neu aufbauen (Start, Fontwechsel)
+#define UPDATE_ALL_UNITS ( MINUTE_UNIT | HOUR_UNIT | DAY_UNIT )
+
+// Handler sammeln Änderungen (BT, Akku, Konfiguration kommen in Schüben),
+// ein Durchlauf pro Frame wendet sie an; der Minutentick kommt allein und
+// läuft sofort
+#define INVALIDATE_DELAY_MS 33
+
+// nächste Minute vorbereiten, wenn die längste Animation (Slide + Move) durch ist
+#define PREPARE_ROWS_DELAY_MS 2500
+
+// Ereignisfilter Statusbalken
+#define BT_ALERT_DELAY_MS   5000  // so lange muss die Verbindung weg sein
+#define BATTERY_ALERT_LEVEL 10    // Vibration beim Erreichen (<=)
+#define BATTERY_ALERT_REARM 20    // erst oberhalb wieder scharf (Hysterese)
+
+// Übergänge je Zeile, genommen wird der billigste (siehe pick_effect)
+#define EFFECTS_HOUR        MOVIE_TEXT_EFFECT( MovieTextUpdateSlideThrough )  // Stunde, Datum
+#define EFFECTS_MINUTE      ( MOVIE_TEXT_EFFECT( MovieTextUpdateWipe ) | \
+                              MOVIE_TEXT_EFFECT( MovieTextUpdateDissolve ) )
+#define EFFECTS_ROW_IN_OUT  ( EFFECTS_MINUTE | MOVIE_TEXT_EFFECT( MovieTextUpdatePush ) )
+#define EFFECTS_LOW_BATTERY MOVIE_TEXT_EFFECT( MovieTextUpdateInstant )
+
+// Storage- und AppMessage-Keys
 enum PersistantSettings
 {
   SETTINGS_SEND_KEYS       = 0,
-  SETTINGS_INVERTER_STATE  = 1,
-  SETTINGS_STATUS_VISIBLE  = 2,
+  SETTINGS_INVERTER_STATE  = 1,  // 1-4 nur noch Storage, übertragen
+  SETTINGS_STATUS_VISIBLE  = 2,  // werden sie als SETTINGS_RECORD
   SETTINGS_ACCEL_CONFIG    = 3,
   SETTINGS_REGULAR_FONTSET = 4,
+  SETTINGS_TRACE_DUMP      = 5,
+  SETTINGS_TELEMETRY       = 6,  // Anfrage vom Telefon + Stundenwerte
+  SETTINGS_RECORD          = 7,  // alle Einstellungen gepackt (settings_schema.h)
+  SETTINGS_TELEMETRY_HOUR  = 8,  // nur Storage: die laufende Telemetrie-Stunde
 };
 
-// Status der einzelnen Zeilen
+// Was der nächste Invalidierungs-Durchlauf erledigen muss
+typedef enum
+{
+  INVALID_ROWS   = 0x01,  // Zeilen neu berechnen (invalid_units)
+  INVALID_STATUS = 0x02,  // Statusbalken neu zeichnen
+  INVALID_VIEWS  = 0x04   // Sichtbarkeit von Statusbalken / Inverter
+} InvalidFlags;
+
+// Übergang der einzelnen Zeilen (siehe plan_minute_rows)
 typedef enum
 {
-  ROW_STATE_KEEP      = 0,
-  ROW_STATE_DISAPPEAR = 1,
-  ROW_STATE_REAPPEAR  = 2,
-  ROW_STATE_STAYDOWN  = 3
+  ROW_STATE_KEEP      = 0,  // Wort bleibt, Layer bleibt stehen
+  ROW_STATE_MOVE      = 1,  // Wort bleibt, Layer wird verschoben
+  ROW_STATE_REPLACE   = 2,  // neues Wort in einem belegten Layer
+  ROW_STATE_APPEAR    = 3,  // neues Wort in einem leeren Layer
+  ROW_STATE_DISAPPEAR = 4   // Layer wird nicht mehr gebraucht
 } RowState;
 
 // Fontset-IDs
@@ -96,44 +147,85 @@ typedef enum
   FONT_SET_REGULAR = 1
 } FontsetId;
 
-// Textdaten
-struct DisplayData
+// Wörter, jedes nur einmal abgelegt; Stunden und Minuten unter 20 sind
+// WORD_NULL + n, Zehner WORD_ZWANZIG + ( n - 2 )
+typedef enum
+{
+  WORD_NONE = 0,
+  WORD_NULL, WORD_EIN, WORD_ZWEI, WORD_DREI, WORD_VIER, WORD_FUENF,
+  WORD_SECHS, WORD_SIEBEN, WORD_ACHT, WORD_NEUN, WORD_ZEHN, WORD_ELF,
+  WORD_ZWOELF, WORD_DREIZEHN, WORD_VIERZEHN, WORD_FUENFZEHN, WORD_SECHZEHN,
+  WORD_SIEBZEHN, WORD_ACHTZEHN, WORD_NEUNZEHN,
+  WORD_ZWANZIG, WORD_DREISSIG, WORD_VIERZIG, WORD_FUENFZIG, WORD_SECHZIG,
+  WORD_UND, WORD_S, WORD_UHR,
+  NUM_WORDS
+} WordId;
+
+#define WORD_ASC     0x01  // Oberlängen, die Zeile darunter rückt nicht nach
+#define WORD_DOTLESS 0x02  // 'i' darf in Minutenzeilen als 'ı' erscheinen
+
+struct Word
 {
-  char    *str;
-  char    *str_dotless;
-  uint8_t is_asc;
+  const char *str;
+  uint8_t     flags;
 } __attribute__((__packed__));
 
-static const struct DisplayData TENS[] = {
-  { "zwanzig" , "zwanzıg", 0 },
-  { "dreissig", ""       , 1 },
-  { "vierzig" , "vıerzıg", 0 },
-  { "fünfzig" , ""       , 1 },
-  { "sechzig" , ""       , 1 }
+static const struct Word WORDS[NUM_WORDS] = {
+  [WORD_NONE]      = { ""        , 0 },
+  [WORD_NULL]      = { "null"    , WORD_ASC },
+  [WORD_EIN]       = { "ein"     , WORD_DOTLESS },
+  [WORD_ZWEI]      = { "zwei"    , 0 },
+  [WORD_DREI]      = { "drei"    , WORD_ASC },
+  [WORD_VIER]      = { "vier"    , WORD_DOTLESS },
+  [WORD_FUENF]     = { "fünf"    , WORD_ASC },
+  [WORD_SECHS]     = { "sechs"   , 0 },
+  [WORD_SIEBEN]    = { "sieben"  , WORD_DOTLESS },
+  [WORD_ACHT]      = { "acht"    , WORD_ASC },
+  [WORD_NEUN]      = { "neun"    , 0 },
+  [WORD_ZEHN]      = { "zehn"    , WORD_ASC },
+  [WORD_ELF]       = { "elf"     , WORD_ASC },
+  [WORD_ZWOELF]    = { "zwölf"   , 0 },
+  [WORD_DREIZEHN]  = { "dreizehn", WORD_ASC },
+  [WORD_VIERZEHN]  = { "vierzehn", WORD_DOTLESS },
+  [WORD_FUENFZEHN] = { "fünfzehn", WORD_ASC },
+  [WORD_SECHZEHN]  = { "sechzehn", 0 },
+  [WORD_SIEBZEHN]  = { "siebzehn", WORD_DOTLESS },
+  [WORD_ACHTZEHN]  = { "achtzehn", WORD_ASC },
+  [WORD_NEUNZEHN]  = { "neunzehn", 0 },
+  [WORD_ZWANZIG]   = { "zwanzig" , WORD_DOTLESS },
+  [WORD_DREISSIG]  = { "dreissig", WORD_ASC },
+  [WORD_VIERZIG]   = { "vierzig" , WORD_DOTLESS },
+  [WORD_FUENFZIG]  = { "fünfzig" , WORD_ASC },
+  [WORD_SECHZIG]   = { "sechzig" , WORD_ASC },
+  [WORD_UND]       = { "und"     , 0 },
+  [WORD_S]         = { "s"       , 0 },
+  [WORD_UHR]       = { "uhr"     , 0 },
 };
 
-static const struct DisplayData TEENS[] = {
-  { "null"    , ""        , 1 },
-  { "ein"     , "eın"     , 0 },
-  { "zwei"    , "zwei"    , 0 },
-  { "drei"    , ""        , 1 },
-  { "vier"    , "vıer"    , 0 },
-  { "fünf"    , ""        , 1 },
-  { "sechs"   , "sechs"   , 0 },
-  { "sieben"  , "sıeben"  , 0 },
-  { "acht"    , ""        , 1 },
-  { "neun"    , "neun"    , 0 },
-  { "zehn"    , ""        , 1 },
-  { "elf"     , ""        , 1 },
-  { "zwölf"   , "zwölf"   , 0 },
-  { "dreizehn", ""        , 1 },
-  { "vierzehn", "vıerzehn", 0 },
-  { "fünfzehn", ""        , 1 },
-  { "sechzehn", "sechzehn", 0 },
-  { "siebzehn", "sıebzehn", 0 },
-  { "achtzehn", ""        , 1 },
-  { "neunzehn", "neunzehn", 0 }
-};
+// Zeileninhalt als Zahl: Wort + Anhang ('und', 's') + Darstellung,
+// oder beim Datum Wochentag / Monat / Tag. 0 ist eine leere Zeile.
+typedef uint16_t RowKey;
+
+#define ROW_KEY_EMPTY     0
+#define ROW_FLAG_DOTLESS  0x0400  // Wörter mit WORD_DOTLESS ohne i-Punkte
+#define ROW_FLAG_INDENT   0x0800  // Leerzeichen voranstellen (Stunde)
+#define ROW_FLAG_DATE     0x8000
+
+#define ROW_KEY( word, suffix, flags ) \
+  ( (RowKey)( (word) | ( (suffix) << 5 ) | (flags) ) )
+#define ROW_KEY_DATE( wday, mday, mon ) \
+  ( (RowKey)( ROW_FLAG_DATE | ( (wday) << 9 ) | ( (mon) << 5 ) | (mday) ) )
+
+#define ROW_KEY_WORD( key )   ( (key) & 0x1F )
+#define ROW_KEY_SUFFIX( key ) ( ( (key) >> 5 ) & 0x1F )
+
+// Ergebnis von plan_minute_rows, je Minutenzeile
+typedef struct
+{
+  MovieTextLayer *layer;
+  RowKey          shown;  // bisheriger Inhalt des Layers
+  RowState        state;
+} RowPlan;
 
 static const char* MONTHS[] = {
   "Januar",
@@ -166,6 +258,12 @@ static MovieTextLayer* row[NUM_ROWS];
 static Layer *status_layer = 0;
 static InverterLayer *charge_layer = 0;
 static GBitmap *icon_bt_on = 0, *icon_bt_off = 0;
+static GBitmap *battery_digits = 0;
+
+// Icons, Ladezustand und Ziffern gibt es nur solange der
+// Statusbalken sichtbar ist (siehe status_res_load)
+#define STATUS_RES_OBJECTS 4
+static bool status_res_loaded = false;
 
 static bool status_bluetooth_conn = false;
 static BatteryChargeState status_battery_charge = { 
@@ -175,92 +273,125 @@ static BatteryChargeState status_battery_charge = {
 };
 static bool status_battery_did_notify = false;
 
-static GFont font_uhr, font_hour, font_minutes, font_date, font_charge;
+// Bluetooth-Alarm wartet auf BT_ALERT_DELAY_MS, verworfene Ereignisse
+static AppTimer *bt_alert_timer = 0;
+static struct
+{
+  uint16_t bluetooth;   // Wackler innerhalb BT_ALERT_DELAY_MS, Wiederholungen
+  uint16_t battery;     // Meldungen ohne sichtbare Änderung
+} events_suppressed = { 0, 0 };
 
-// Puffer für aktive / alte Zeileninhalte
-static char row_cur_data[NUM_ROWS][ROW_BUF_SIZE];
-static uint8_t row_cur_cnt, row_old_cnt;
+// bis STARTUP_CUSTOM_FONTS Systemfonts als Platzhalter, danach das Fontset
+#define FONTSET_OBJECTS 4
+static GFont font_uhr, font_hour, font_minutes, font_date;
 
-// aktive / alte Layerpositionen
-static GPoint row_cur_pos[NUM_ROWS],
-              row_old_pos[NUM_ROWS];
+// Startstufen, jede landet mit der Zeit seit init() im Trace
+typedef enum
+{
+  STARTUP_SYSTEM_FONTS = 0,  // Fenster steht, Zeilen versteckt
+  STARTUP_FIRST_FRAME,       // erstes Bild gezeichnet
+  STARTUP_CUSTOM_FONTS,      // Fontset geladen, Zeilen laufen ein
+  STARTUP_STATUS,            // Statusbalken-Resourcen
+  STARTUP_MESSAGES,          // AppMessage, Trace
+  STARTUP_FINAL_FRAME        // erstes Bild mit allem
+} StartupStage;
+
+static StartupStage startup_stage = STARTUP_SYSTEM_FONTS;
+static time_t startup_sec = 0;
+static uint16_t startup_ms = 0;
+static AppTimer *startup_timer = 0;
+static AppTimer *startup_timeout = 0;
+static Layer *startup_probe = 0;  // zeichnet nichts, bemerkt nur Bilder
+
+// Zeileninhalte einer Minute: Schlüssel, fertiger Text und Position
+typedef struct
+{
+  RowKey  key[NUM_ROWS];
+  char    data[NUM_ROWS][ROW_BUF_SIZE];
+  GPoint  pos[NUM_ROWS];
+  uint8_t cnt;
+} RowSet;
+
+// aktuelle Zeilen und Inhalt der Layer in row[]
+static RowSet row_cur;
+static RowKey row_shown_key[NUM_ROWS];
+
+// nächste Minute, in der Ruhe nach den Animationen vorbereitet
+// (on_prepare_rows); der Tick übernimmt sie nur noch
+static RowSet row_next;
+static RowPlan row_next_plan[NUM_ROWS];
+static struct tm row_next_time;
+static TimeUnits row_next_units;
+static bool row_next_regular = false;  // Fontset, für das die Positionen gelten
+static bool row_next_prepared = false;
+static AppTimer *prepare_timer = 0;
 
 static uint8_t first_update = 1;
 
+// ausstehende Invalidierung und Zähler (Ereignisse / Durchläufe)
+static uint8_t invalid_flags = 0;
+static TimeUnits invalid_units = 0;
+static struct tm invalid_time;
+static uint8_t invalid_events = 0;
+static AppTimer *invalidate_timer = 0;
+static struct
+{
+  uint16_t events;
+  uint16_t passes;
+} invalidate_stats = { 0, 0 };
+
 // Timer zum deaktivieren der Gestenerkennung
 static AppTimer *accel_config_timer = 0;
 
 // Konfigwerte
-static AppSync app;
-static uint8_t appsync_buffer[64];
-static bool settings_inverter_state  = false;
-static bool settings_status_visible  = false;
-static bool settings_accel_config    = true;
-static bool settings_regular_fontset = false;
-
-static void copy_time( uint8_t *is_ascii, uint8_t *ten_and_mark )
+static bool settings_inverter_state  = SETTING_DEFAULT_INVERTER_STATE;
+static bool settings_status_visible  = SETTING_DEFAULT_STATUS_VISIBLE;
+static bool settings_accel_config    = SETTING_DEFAULT_ACCEL_CONFIG;
+static bool settings_regular_fontset = SETTING_DEFAULT_REGULAR_FONTSET;
+
+// Erzeugt nur die Zeilen neu, deren Zeiteinheit sich geändert hat:
+// Datum bei DAY_UNIT, Stunde + 'uhr' bei HOUR_UNIT, Minuten immer
+static void copy_time( RowSet *set, struct tm *now, TimeUnits units_changed )
 {
-  TRACE
+  TRACE( TRACE_COPY_TIME )
 
-  int hours, minutes, tens, ones;
-
-#if TEST_DATE
-  struct tm* now = localtime( &test_dates[test_date_pos++]); 
+  int hours, minutes, tens, ones, i;
 
-  if( test_date_pos > 10 )
+  if( units_changed & DAY_UNIT )
   {
-    test_date_pos = 0;
+    set->key[0] = ROW_KEY_DATE( now->tm_wday, now->tm_mday, now->tm_mon );
   }
-#else
-  int32_t time_val = time( NULL );
-  struct tm* now = localtime( &time_val );
-#endif
 
-  row_cur_cnt = 0;
+  if( units_changed & HOUR_UNIT )
+  {
+    hours = now->tm_hour % 12;
 
-  is_ascii[row_cur_cnt] = 0;
+    if( now->tm_hour == 12 )
+    {
+      hours = 12;
+    }
 
-  snprintf( row_cur_data[row_cur_cnt++], ROW_BUF_SIZE, "%s %d. %s",
-            WEEKDAYS[now->tm_wday], (int)now->tm_mday, MONTHS[now->tm_mon] );
+    set->key[1] = ROW_KEY( WORD_NULL + hours, WORD_NONE, ROW_FLAG_INDENT );
+    set->key[2] = ROW_KEY( WORD_UHR, WORD_NONE, 0 );
+  }
 
-  hours   = now->tm_hour % 12;
   minutes = now->tm_min;
 
-  if( now->tm_hour == 12 )
+  for( i = FIRST_MINUTE_ROW; i < NUM_ROWS; ++i )
   {
-    hours = 12;
+    set->key[i] = ROW_KEY_EMPTY;
   }
+  set->cnt = FIRST_MINUTE_ROW;
 
-  is_ascii[row_cur_cnt] = TEENS[hours].is_asc;
-  snprintf( row_cur_data[ row_cur_cnt++ ], ROW_BUF_SIZE, " %s", TEENS[hours].str );
-  snprintf( row_cur_data[ row_cur_cnt++ ], ROW_BUF_SIZE, "uhr" );
-
-  if( ten_and_mark )
-  {
-    *ten_and_mark = 0;
-  }
   if( minutes == 0 )
   {
     // pass..
   }
   else if( minutes < 20 )
   {
-    is_ascii[row_cur_cnt] = TEENS[minutes].is_asc;
-    if( is_ascii[row_cur_cnt] == 0 )
-    {
-      strncpy( row_cur_data[row_cur_cnt], TEENS[minutes].str_dotless,
-               ROW_BUF_SIZE );
-    }
-    else
-    {
-      strncpy( row_cur_data[row_cur_cnt], TEENS[minutes].str,
-               ROW_BUF_SIZE );
-    }
-    if(minutes == 1)
-    {
-      strncat( row_cur_data[row_cur_cnt], "s", ROW_BUF_SIZE );
-    }
-    ++row_cur_cnt;
+    set->key[set->cnt++] = ROW_KEY( WORD_NULL + minutes,
+                                          minutes == 1 ? WORD_S : WORD_NONE,
+                                          ROW_FLAG_DOTLESS );
   }
   else
   {
@@ -269,243 +400,443 @@ static void copy_time( uint8_t *is_ascii, uint8_t *ten_and_mark )
 
     if( ones == 0 )
     {
-      is_ascii[row_cur_cnt] = TENS[tens - 2].is_asc;
-      if( is_ascii[row_cur_cnt] == 0 && tens != 2 )
-      {
-        strncpy( row_cur_data[row_cur_cnt++], TENS[tens-2].str_dotless,
-                 ROW_BUF_SIZE );
-      }
-      else
-      {
-        strncpy( row_cur_data[row_cur_cnt++], TENS[tens-2].str,
-                 ROW_BUF_SIZE );
-      }
+      // 'zwanzig' allein behält seine i-Punkte
+      set->key[set->cnt++] = ROW_KEY( WORD_ZWANZIG + tens - 2, WORD_NONE,
+                                            tens != 2 ? ROW_FLAG_DOTLESS : 0 );
     }
     else
     {
-      if( ones == 1 )
-      {
-        if( ten_and_mark )
-        {
-          *ten_and_mark = 1;
-        }
-      }
+      set->key[set->cnt++] = ROW_KEY( WORD_NULL + ones, WORD_UND, ROW_FLAG_DOTLESS );
+      set->key[set->cnt++] = ROW_KEY( WORD_ZWANZIG + tens - 2, WORD_NONE, ROW_FLAG_DOTLESS );
+    }
+  }
+}
 
-      is_ascii[row_cur_cnt] = TEENS[ones].is_asc;
-      if( is_ascii[row_cur_cnt] == 0 )
-      {
-        strncpy( row_cur_data[row_cur_cnt], TEENS[ones].str_dotless,
-                 ROW_BUF_SIZE );
-      }
-      else
-      {
-        strncpy( row_cur_data[row_cur_cnt], TEENS[ones].str,
-                 ROW_BUF_SIZE ); 
-      }
-      strncat( row_cur_data[row_cur_cnt], "und", ROW_BUF_SIZE );
-      ++row_cur_cnt;
+static bool row_key_is_asc( RowKey key )
+{
+  return ( key & ROW_FLAG_DATE ) == 0 &&
+         ( WORDS[ROW_KEY_WORD( key )].flags & WORD_ASC ) != 0;
+}
 
-      is_ascii[row_cur_cnt] = TENS[tens-2].is_asc;
-      if( is_ascii[row_cur_cnt] == 0 )
-      {
-        strncpy( row_cur_data[row_cur_cnt++], TENS[tens-2].str_dotless,
-                 ROW_BUF_SIZE );
-      }
-      else
-      {
-        strncpy( row_cur_data[row_cur_cnt++], TENS[tens-2].str,
-                 ROW_BUF_SIZE ); 
-      }
+static void append_word( StrBuilder *sb, uint8_t word, bool dotless )
+{
+  const char *str = WORDS[word].str;
+
+  if( !dotless || ( WORDS[word].flags & WORD_DOTLESS ) == 0 )
+  {
+    str_builder_append( sb, str );
+    return;
+  }
+
+  for( ; *str; ++str )
+  {
+    if( *str == 'i' )
+    {
+      str_builder_append( sb, "ı" );
+    }
+    else
+    {
+      str_builder_append_char( sb, *str );
     }
   }
 }
 
-static void update_if_needed( MovieTextLayer *row, const char* row_buf,
-                              GPoint* old_pos, GPoint* new_pos )
+// Text einer Zeile, erzeugt in compose_rows()
+static void render_row( RowKey key, char *buf )
+{
+  StrBuilder sb;
+
+  str_builder_init( &sb, buf, ROW_BUF_SIZE );
+
+  if( key & ROW_FLAG_DATE )
+  {
+    str_builder_append( &sb, WEEKDAYS[( key >> 9 ) & 0x07] );
+    str_builder_append_char( &sb, ' ' );
+    str_builder_append_uint( &sb, key & 0x1F );
+    str_builder_append( &sb, ". " );
+    str_builder_append( &sb, MONTHS[( key >> 5 ) & 0x0F] );
+    return;
+  }
+
+  if( key & ROW_FLAG_INDENT )
+  {
+    str_builder_append_char( &sb, ' ' );
+  }
+  append_word( &sb, ROW_KEY_WORD( key ), key & ROW_FLAG_DOTLESS );
+  append_word( &sb, ROW_KEY_SUFFIX( key ), key & ROW_FLAG_DOTLESS );
+}
+
+static bool row_at( MovieTextLayer *row, const GPoint* pos )
+{
+  GPoint origin = movie_textLayer_get_origin( row );
+  return origin.x == pos->x && origin.y == pos->y;
+}
+
+static void move_if_needed( int i )
+{
+  if( !row_at( row[i], &row_cur.pos[i] ) )
+  {
+    movie_text_layer_set_origin( row[i], row_cur.pos[i], MovieTextUpdateInstant, false );
+  }
+}
+
+// billigster erlaubter Übergang, bei leerem Akku auch ganz ohne Animation
+static MovieTextUpdateMode pick_effect( uint16_t effects )
+{
+  if( !status_battery_charge.is_charging &&
+       status_battery_charge.charge_percent <= BATTERY_ALERT_LEVEL )
+  {
+    effects |= EFFECTS_LOW_BATTERY;
+  }
+  return movie_text_layer_cheapest_effect( effects );
+}
+
+static void update_if_needed( int i, uint16_t effects )
 {
-  TRACE
+  TRACE_ARGS( TRACE_UPDATE_IF_NEEDED, i, 0 )
 
-  if( strcmp( row_buf, movie_text_layer_get_text( row ) ) )
+  if( row_cur.key[i] != row_shown_key[i] )
   {
-    if( new_pos->y != old_pos->y )
+    if( !row_at( row[i], &row_cur.pos[i] ) )
     {
-      movie_text_layer_set_origin( row, *new_pos, MovieTextUpdateDelay, false );
+      movie_text_layer_set_origin( row[i], row_cur.pos[i], MovieTextUpdateDelay, false );
     }
-    movie_text_layer_set_text( row, row_buf, MovieTextUpdateSlideThrough, false );
+
+    row_shown_key[i] = row_cur.key[i];
+    movie_text_layer_set_text( row[i], row_cur.data[i], pick_effect( effects ), false );
   }
   else
   {
-      movie_text_layer_set_origin( row, *new_pos, MovieTextUpdateInstant, false );
+    move_if_needed( i );
   }
 }
 
-static void update_and_move( MovieTextLayer *row1, const char* row1_text, GPoint *row1_pos,
-                             MovieTextLayer *row2, const char* row2_text, GPoint *row2_pos )
+// Vergleicht die angezeigten Minutenwörter mit den neuen und verteilt die
+// Layer so, dass möglichst wenig animiert werden muss:
+//  - Wörter die bleiben behalten ihren Layer (höchstens verschoben)
+//  - neue Wörter bekommen einen freien Layer, bevorzugt am selben Platz
+//  - übrige Layer mit Text werden ausgeblendet
+static void plan_minute_rows( const RowSet *set, RowPlan plan[NUM_ROWS] )
 {
-  TRACE
+  TRACE( TRACE_PLAN_MINUTE_ROWS )
 
-  movie_text_layer_set_origin( row1, *row1_pos, MovieTextUpdateDelay, false );
-  movie_text_layer_set_text( row1, row1_text, MovieTextUpdateSlideThrough, false );
+  bool claimed[NUM_ROWS];
+  int i, j;
 
-  if( row2 && row2_text && row2_pos )
+  memset( claimed, 0, sizeof( claimed ) );
+  memset( plan, 0, sizeof( RowPlan ) * NUM_ROWS );
+
+  for( i = FIRST_MINUTE_ROW; i < set->cnt; ++i )
   {
-    movie_text_layer_set_origin( row2, *row2_pos, MovieTextUpdateDelay, false );
-    movie_text_layer_set_text( row2, row2_text, MovieTextUpdateSlideThrough, false );
+    for( j = FIRST_MINUTE_ROW; j < NUM_ROWS; ++j )
+    {
+      if( !claimed[j] && set->key[i] == row_shown_key[j] )
+      {
+        claimed[j] = true;
+        plan[i].layer = row[j];
+        plan[i].shown = row_shown_key[j];
+        plan[i].state = row_at( row[j], &set->pos[i] ) ? ROW_STATE_KEEP
+                                                           : ROW_STATE_MOVE;
+        break;
+      }
+    }
+  }
+
+  for( i = FIRST_MINUTE_ROW; i < set->cnt; ++i )
+  {
+    if( plan[i].layer )
+    {
+      continue;
+    }
+
+    for( j = i; claimed[j]; )
+    {
+      // es gibt immer genau so viele Layer wie Minutenzeilen
+      j = ( j + 1 < NUM_ROWS ) ? j + 1 : FIRST_MINUTE_ROW;
+    }
+
+    claimed[j] = true;
+    plan[i].layer = row[j];
+    plan[i].shown = row_shown_key[j];
+    plan[i].state = row_shown_key[j] != ROW_KEY_EMPTY ? ROW_STATE_REPLACE
+                                                      : ROW_STATE_APPEAR;
+  }
+
+  for( i = set->cnt, j = FIRST_MINUTE_ROW; j < NUM_ROWS; ++j )
+  {
+    if( !claimed[j] )
+    {
+      plan[i].layer = row[j];
+      plan[i].shown = row_shown_key[j];
+      plan[i].state = row_shown_key[j] != ROW_KEY_EMPTY ? ROW_STATE_DISAPPEAR
+                                                        : ROW_STATE_KEEP;
+      ++i;
+    }
   }
 }
 
-static void update_rows( void )
+static void apply_minute_rows( RowPlan plan[NUM_ROWS] )
 {
-  TRACE
+  TRACE( TRACE_APPLY_MINUTE_ROWS )
 
-  int base_offset_y = 0, offset_y = 0, i;
-  uint8_t is_asc[NUM_ROWS], ten_and_mark = 0;
+  int i;
 
-  // alte Zeileninhalte / Positionen speichern
-  memcpy( row_old_pos, row_cur_pos, sizeof( GPoint ) * row_cur_cnt );
-  row_old_cnt = row_cur_cnt;
+  for( i = FIRST_MINUTE_ROW; i < NUM_ROWS; ++i )
+  {
+    row[i] = plan[i].layer;
+    row_shown_key[i] = plan[i].shown;
+
+    switch( plan[i].state )
+    {
+      case ROW_STATE_KEEP:
+        break;
+
+      case ROW_STATE_MOVE:
+        movie_text_layer_set_origin( row[i], row_cur.pos[i], MovieTextUpdateInstant, false );
+        break;
+
+      case ROW_STATE_REPLACE:
+        update_if_needed( i, EFFECTS_MINUTE );
+        break;
+
+      case ROW_STATE_APPEAR:
+        // leerer Layer, kann unsichtbar an die neue Position springen
+        row_shown_key[i] = row_cur.key[i];
+        movie_text_layer_set_origin( row[i], row_cur.pos[i], MovieTextUpdateNone, false );
+        movie_text_layer_set_text( row[i], row_cur.data[i], pick_effect( EFFECTS_ROW_IN_OUT ), false );
+        break;
+
+      case ROW_STATE_DISAPPEAR:
+        row_shown_key[i] = ROW_KEY_EMPTY;
+        movie_text_layer_set_text( row[i], "", pick_effect( EFFECTS_ROW_IN_OUT ), false );
+        break;
+    }
+  }
+}
+
+// Zeilen einer Minute vollständig berechnen: Schlüssel, Texte und
+// Positionen. set enthält die vorige Minute, nur geänderte Einheiten
+// werden neu erzeugt und nur Zeilen mit neuem Schlüssel neu geschrieben.
+static void compose_rows( RowSet *set, struct tm *now, TimeUnits units_changed )
+{
+  int base_offset_y = 0, offset_y = 0, i;
+  RowKey prev_key[NUM_ROWS];
 
-  memset( row_cur_pos, 0, sizeof( row_cur_pos ) );
-  memset( row_cur_data, 0, sizeof( row_cur_data ) );
-  row_cur_cnt = 0;
+  memset( set->pos, 0, sizeof( set->pos ) );
+  memcpy( prev_key, set->key, sizeof( prev_key ) );
 
-  memset( is_asc, 0, sizeof( is_asc ) );
+  copy_time( set, now, units_changed );
 
-  copy_time( is_asc, &ten_and_mark );
+  for( i = 0; i < NUM_ROWS; ++i )
+  {
+    if( set->key[i] != prev_key[i] )
+    {
+      render_row( set->key[i], set->data[i] );
+    }
+  }
 
-  row_cur_pos[0].x = row_cur_pos[1].x = row_cur_pos[2].x = 
-  row_cur_pos[3].x = row_cur_pos[4].x = BASE_ROW_X;
+  set->pos[0].x = set->pos[1].x = set->pos[2].x = 
+  set->pos[3].x = set->pos[4].x = BASE_ROW_X;
 
   /* row[1] - immer die Stunde */
-  row_cur_pos[1].y = base_offset_y;
+  set->pos[1].y = base_offset_y;
   /* row[2] - immer 'uhr' */
-  row_cur_pos[2].y = ( base_offset_y += ROW1_HIGHT );
+  set->pos[2].y = ( base_offset_y += ROW1_HIGHT );
 
   /* row[3] / row[4] - minuten */
-  if( row_cur_cnt >= 4 )
+  if( set->cnt >= 4 )
   {
-    row_cur_pos[3].y = ( base_offset_y += ( ROW2_HIGHT - (is_asc[3] ? 0 : DOTLESS_X) ) );
+    set->pos[3].y = ( base_offset_y += ( ROW2_HIGHT - (row_key_is_asc( set->key[3] ) ? 0 : DOTLESS_X) ) );
   }
-  if( row_cur_cnt == 5 )
+  if( set->cnt == 5 )
   {
-    row_cur_pos[4].y = ( base_offset_y += ( ROW3_HIGHT - (is_asc[4] ? 0 : DOTLESS_X) ) );
+    set->pos[4].y = ( base_offset_y += ( ROW3_HIGHT - (row_key_is_asc( set->key[4] ) ? 0 : DOTLESS_X) ) );
   }
   /* row[0] - immer das Datum */
-  row_cur_pos[0].y = ( base_offset_y += DATE_HIGHT );
+  set->pos[0].y = ( base_offset_y += DATE_HIGHT );
   
   base_offset_y += 22;
   offset_y = ( SCREEN_HIGHT - base_offset_y ) / 2;
 
   /* finale positionen */
-  for( i = 0; i < row_cur_cnt; ++i )
+  for( i = 0; i < set->cnt; ++i )
   {
     if( settings_regular_fontset )
     {
-      row_cur_pos[i].x = REGULAR_ROW_X;
+      set->pos[i].x = REGULAR_ROW_X;
     }
     else
     {
-      row_cur_pos[i].x -= row_cur_pos[i].y / 5;
+      set->pos[i].x -= set->pos[i].y / 5;
     }
-    row_cur_pos[i].y += offset_y;
+    set->pos[i].y += offset_y;
   }
   if( settings_regular_fontset == false )
   {
-    row_cur_pos[0].x += 4; // Datum weiter nach Rechts
+    set->pos[0].x += 4; // Datum weiter nach Rechts
+  }
+  set->pos[1].x -= 7; // Leerzeichen vor jeder Stunde ausgleichen
+}
+
+static bool rows_idle( void )
+{
+  int i;
+
+  for( i = 0; i < NUM_ROWS; ++i )
+  {
+    if( movie_text_layer_get_state( row[i] ) != MovieTextStateIdle )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void on_prepare_rows( void *data );
+
+static void schedule_prepare_rows( uint32_t delay )
+{
+  if( prepare_timer == 0 || !app_timer_reschedule( prepare_timer, delay ) )
+  {
+    prepare_timer = app_timer_register( delay, on_prepare_rows, NULL );
+  }
+}
+
+// Rechnet den nächsten Minutenwechsel vorab: Schlüssel, Texte, Positionen
+// und die Verteilung der Minutenzeilen. Die Layer müssen dafür stehen,
+// plan_minute_rows() vergleicht mit ihren aktuellen Positionen.
+static void on_prepare_rows( void *data __attribute__((__unused__)) )
+{
+  prepare_timer = 0;
+
+  if( first_update || ( invalid_flags & INVALID_ROWS ) || !rows_idle() )
+  {
+    schedule_prepare_rows( PREPARE_ROWS_DELAY_MS );
+    return;
+  }
+
+  int32_t next = ( time( NULL ) / 60 + 1 ) * 60;
+
+  row_next_time = *localtime( &next );
+  row_next_units = MINUTE_UNIT;
+  if( row_next_time.tm_min == 0 )
+  {
+    row_next_units |= ( row_next_time.tm_hour == 0 ) ? ( HOUR_UNIT | DAY_UNIT ) : HOUR_UNIT;
   }
-  row_cur_pos[1].x -= 7; // Leerzeichen vor jeder Stunde ausgleichen
+
+  TRACE_ARGS( TRACE_PREPARE_ROWS, row_next_units, row_next_time.tm_min )
+
+  row_next = row_cur;
+  compose_rows( &row_next, &row_next_time, row_next_units );
+  plan_minute_rows( &row_next, row_next_plan );
+  row_next_regular = settings_regular_fontset;
+  row_next_prepared = true;
+}
+
+// übernimmt row_next als aktuelle Zeilen und startet die Animationen
+static void commit_rows( TimeUnits units_changed, RowPlan plan[NUM_ROWS] )
+{
+  int i;
+
+  row_cur = row_next;
 
   if( first_update )
   {
     // Neustart des Watchface
-    row_old_cnt = row_cur_cnt;
-    memcpy( row_old_pos, row_cur_pos, sizeof( row_cur_pos ) );
-
     for( i = 0; i < NUM_ROWS; ++i )
     {
-      if( i < row_cur_cnt )
+      if( i < row_cur.cnt )
       {
-        movie_text_layer_set_origin( row[i], row_cur_pos[i], MovieTextUpdateNone, false );
+        movie_text_layer_set_origin( row[i], row_cur.pos[i], MovieTextUpdateNone, false );
       }
     }
-
-    ten_and_mark = 0;
   }
 
   //
   // TextLayer setzen und animieren
   //
 
+  // Zeilen deren Text sich nicht geändert haben kann, werden nur verschoben
+
   // stunden, immer da
-  update_if_needed( row[1], row_cur_data[1], &row_old_pos[1], &row_cur_pos[1] );
+  if( units_changed & HOUR_UNIT )
+  {
+    update_if_needed( 1, EFFECTS_HOUR );
+  }
+  else
+  {
+    move_if_needed( 1 );
+  }
   
   // 'uhr', immer da
   if( first_update )
   {
     first_update = 0;
-    movie_text_layer_set_origin( row[2], row_cur_pos[2], MovieTextUpdateDelay, false );
-    movie_text_layer_set_text( row[2], row_cur_data[2], MovieTextUpdateSlideThrough, false );
+    row_shown_key[2] = row_cur.key[2];
+    movie_text_layer_set_origin( row[2], row_cur.pos[2], MovieTextUpdateDelay, false );
+    movie_text_layer_set_text( row[2], row_cur.data[2], MovieTextUpdateSlideThrough, false );
   }
   else
   {
-    movie_text_layer_set_text( row[2], row_cur_data[2], MovieTextUpdateInstant, false );
-    movie_text_layer_set_origin( row[2], row_cur_pos[2], MovieTextUpdateInstant, false );
+    move_if_needed( 2 );
   }
 
   // Datum, immer da
-  update_if_needed( row[0], row_cur_data[0], &row_old_pos[0], &row_cur_pos[0] );
-
-  // Bewegte zeile - 3 / 4 für Minuten
-  //
-  // Möglich kombinationen:
-  //
-  // XX Uhr    -> XX Uhr  1: cnt 3 -> 4
-  // XX Uhr 19 -> XX Uhr 20: cnt 4 -> 5  'einund / zwanzig'
-  // XX Uhr 29 -> XX Uhr 30: cnt 5 -> 4
-  // XX Uhr 59 -> XX Uhr   : cnt 5 -> 3
-  // keine Änderung ->     : cnt == old_cnt
-  //
-  if( row_old_cnt == 3 && row_cur_cnt == 4 )
+  if( units_changed & DAY_UNIT )
   {
-    // Stunde -> Stunde + Minute
-    update_and_move( row[3], row_cur_data[3], &row_cur_pos[3], NULL, NULL, NULL );
+    update_if_needed( 0, EFFECTS_HOUR );
   }
-  else if( row_old_cnt == 4 && row_cur_cnt == 5 )
+  else
   {
-    // Stunde + Minute -> Stunde + Minuten + Zehner
-    update_and_move( row[3], row_cur_data[3], &row_cur_pos[3],
-                     row[4], row_cur_data[4], &row_cur_pos[4] );
+    move_if_needed( 0 );
   }
-  else if( row_old_cnt == 5 && row_cur_cnt == 4 )
+
+  // Minutenzeilen
+  apply_minute_rows( plan );
+
+  // die Vorbereitung galt dem alten Stand
+  row_next_prepared = false;
+  schedule_prepare_rows( PREPARE_ROWS_DELAY_MS );
+}
+
+// Minutenwechsel mit vorbereitetem Plan: nur noch übernehmen und animieren.
+// Passt er nicht (andere Minute, weitere Einheiten, Fontwechsel), rechnet
+// update_rows() neu; jede Übernahme verwirft ihn.
+static bool commit_prepared_rows( struct tm *now, TimeUnits units_changed )
+{
+  if( !row_next_prepared || first_update || row_next_regular != settings_regular_fontset ||
+      ( units_changed & UPDATE_ALL_UNITS & ~row_next_units ) ||
+      now->tm_min  != row_next_time.tm_min  || now->tm_hour != row_next_time.tm_hour ||
+      now->tm_mday != row_next_time.tm_mday || now->tm_mon  != row_next_time.tm_mon )
   {
-    // Stunde + Minute + Zehner -> Stunde + Minute
-    update_and_move( row[3], "", &row_cur_pos[3],
-                     row[4], row_cur_data[3], &row_cur_pos[3] );
+    return false;
   }
-  else if( row_old_cnt == 5 && row_cur_cnt == 3 )
+
+  commit_rows( row_next_units, row_next_plan );
+  return true;
+}
+
+static void update_rows( struct tm *now, TimeUnits units_changed )
+{
+  RowPlan plan[NUM_ROWS];
+
+  if( commit_prepared_rows( now, units_changed ) )
   {
-    // Stunde + Minute + Zehner -> Stunde
-    update_and_move( row[3], "", &row_cur_pos[3],
-                     row[4], "", &row_cur_pos[4] );
+    TRACE_ARGS( TRACE_UPDATE_ROWS, units_changed, 1 )
+    return;
   }
-  else if( row_old_cnt == row_cur_cnt )
-  {
-    // nur update, keine Zeilenänderung
-    if( row_old_cnt == 3 )
-    {
-      movie_text_layer_set_text( row[3], "", MovieTextUpdateInstant, false );
-      movie_text_layer_set_text( row[4], "", MovieTextUpdateInstant, false );
-    }
-    if( row_old_cnt >= 4 )
-    {
-      update_if_needed( row[3], row_cur_data[3], &row_old_pos[3], &row_cur_pos[3] );
-    }
 
-    if( row_old_cnt == 5 )
-    {
-      update_if_needed( row[4], row_cur_data[4], &row_old_pos[4], &row_cur_pos[4] );
-    }
+  TRACE_ARGS( TRACE_UPDATE_ROWS, units_changed, 0 )
+
+  if( first_update )
+  {
+    units_changed |= UPDATE_ALL_UNITS;
   }
+
+  row_next = row_cur;
+  compose_rows( &row_next, now, units_changed );
+  plan_minute_rows( &row_next, plan );
+  commit_rows( units_changed, plan );
 }
 
 static void update_status( struct Layer *layer, GContext *ctx )
@@ -513,9 +844,9 @@ static void update_status( struct Layer *layer, GContext *ctx )
   //TRACE
   char batt_text[5] = "\0\0\0\0\0";
   int  batt_charge = (int)status_battery_charge.charge_percent;
+  StrBuilder sb;
 
   GRect batt_outline = GRect( SCREEN_WIDTH - 22, 2, 20, 11 );
-  GRect batt_label   = GRect( SCREEN_WIDTH - 22, 2, 20, 10 );
 
   GRect batt_fill    = GRect( batt_outline.origin.x + 2,
                               batt_outline.origin.y + 2,
@@ -526,35 +857,193 @@ static void update_status( struct Layer *layer, GContext *ctx )
 
   graphics_context_set_stroke_color( ctx, GColorWhite );
   graphics_context_set_fill_color( ctx, GColorBlack );
-  graphics_context_set_text_color( ctx, GColorWhite );
   
   graphics_fill_rect( ctx, batt_outline, 0, GCornerNone );
   graphics_draw_rect( ctx, batt_outline );
 
   if( batt_charge > 0 )
   {
-    snprintf( batt_text, 4, "%d%c", batt_charge, status_battery_charge.is_charging ? '+':'\0' );
-    graphics_draw_text( ctx, batt_text, font_charge, batt_label,
-                        GTextOverflowModeWordWrap, GTextAlignmentCenter, NULL );
+    // höchstens drei Zeichen: "100" verdrängt das '+'
+    str_builder_init( &sb, batt_text, 4 );
+    str_builder_append_uint( &sb, batt_charge );
+    if( status_battery_charge.is_charging )
+    {
+      str_builder_append_char( &sb, '+' );
+    }
+    digit_label_draw( ctx, battery_digits, batt_text, batt_outline );
   }
 
   // Die "Füllung" der Batterie wird via Invertieren realisiert
   // So kann auch der Text teilinvers dargestellt werden.
-  layer_set_frame( inverter_layer_get_layer( charge_layer ), batt_fill );
+  if( charge_layer )
+  {
+    layer_set_frame( inverter_layer_get_layer( charge_layer ), batt_fill );
+  }
 
   graphics_draw_bitmap_in_rect(ctx, status_bluetooth_conn ? icon_bt_on
                                                           : icon_bt_off,
                                                             bluetooth_icon );
+
+  STACK_CHECK( STACK_PROBE_DRAW_STATUS )
+}
+
+//
+// Statusbalken-Resourcen
+//
+
+static GFont load_font( uint32_t resource_id )
+{
+  return ui_arena_put( UI_ARENA_FONT, fonts_load_custom_font( resource_get_handle( resource_id ) ) );
+}
+
+static void unload_font( GFont font )
+{
+  fonts_unload_custom_font( ui_arena_take( font ) );
+}
+
+static void status_res_load( void )
+{
+  if( status_res_loaded )
+  {
+    return;
+  }
+
+  icon_bt_on  = ui_arena_put( UI_ARENA_BITMAP, gbitmap_create_with_resource( RESOURCE_ID_IMAGE_BT_ON_ICON ) );
+  icon_bt_off = ui_arena_put( UI_ARENA_BITMAP, gbitmap_create_with_resource( RESOURCE_ID_IMAGE_BT_OFF_ICON ) );
+  battery_digits = ui_arena_put( UI_ARENA_BITMAP, gbitmap_create_with_resource( RESOURCE_ID_IMAGE_BATTERY_DIGITS ) );
+
+  charge_layer = ui_arena_put( UI_ARENA_INVERTER, inverter_layer_create( GRectZero ) );
+  layer_add_child( status_layer, inverter_layer_get_layer( charge_layer ) );
+
+  status_res_loaded = true;
+}
+
+static void status_res_unload( void )
+{
+  if( !status_res_loaded )
+  {
+    return;
+  }
+
+  layer_remove_from_parent( inverter_layer_get_layer( charge_layer ) );
+  inverter_layer_destroy( ui_arena_take( charge_layer ) );
+  gbitmap_destroy( ui_arena_take( battery_digits ) );
+  gbitmap_destroy( ui_arena_take( icon_bt_on ) );
+  gbitmap_destroy( ui_arena_take( icon_bt_off ) );
+
+  charge_layer = 0;
+  battery_digits = 0;
+  icon_bt_on = icon_bt_off = 0;
+  status_res_loaded = false;
+}
+
+//
+// Invalidierung
+//
+// Handler ändern nur den Zustand und merken sich was betroffen ist,
+// on_invalidate() wendet alles gesammelt an und markiert nur die
+// betroffenen Layer. invalidate() wartet INVALIDATE_DELAY_MS auf weitere
+// Ereignisse, invalidate_now() nimmt Ausstehendes mit und läuft sofort.
+//
+
+static void on_invalidate( void *data __attribute__((__unused__)) )
+{
+  uint8_t flags = invalid_flags;
+
+  TRACE_ARGS( TRACE_INVALIDATE, flags, invalid_events )
+
+  invalidate_timer = 0;
+  invalid_flags = 0;
+  invalid_events = 0;
+  ++invalidate_stats.passes;
+
+  if( flags & INVALID_VIEWS )
+  {
+    // erst laden, dann zeigen; erst verstecken, dann freigeben
+    if( settings_status_visible )
+    {
+      status_res_load();
+    }
+    layer_set_hidden( status_layer, !settings_status_visible );
+    if( !settings_status_visible )
+    {
+      status_res_unload();
+    }
+    layer_set_hidden( inverter_layer_get_layer( inverter_layer ), !settings_inverter_state );
+  }
+
+  if( flags & INVALID_ROWS )
+  {
+    TimeUnits units = invalid_units;
+
+    invalid_units = 0;
+    update_rows( &invalid_time, units );
+  }
+
+  if( ( flags & INVALID_STATUS ) && settings_status_visible )
+  {
+    layer_mark_dirty( status_layer );
+  }
+
+  STACK_CHECK( STACK_PROBE_INVALIDATE )
+}
+
+static void invalidate_merge( uint8_t flags )
+{
+  invalid_flags |= flags;
+  ++invalid_events;
+  ++invalidate_stats.events;
+}
+
+static void invalidate( uint8_t flags )
+{
+  invalidate_merge( flags );
+
+  if( invalidate_timer == 0 )
+  {
+    invalidate_timer = app_timer_register( INVALIDATE_DELAY_MS, on_invalidate, NULL );
+  }
+}
+
+static void invalidate_now( uint8_t flags )
+{
+  invalidate_merge( flags );
+
+  if( invalidate_timer )
+  {
+    app_timer_cancel( invalidate_timer );
+  }
+  on_invalidate( NULL );
 }
 
-static void toggle_view_setting( Layer *layer, int storage_key, bool *value )
+static void invalidate_rows( struct tm *now, TimeUnits units_changed )
 {
-  TRACE
+  invalid_time = *now;
+  invalid_units |= units_changed;
+  invalidate( INVALID_ROWS );
+}
+
+// Minutentick: ohne Timer, kein zusätzliches Aufwachen pro Minute
+static void invalidate_rows_now( struct tm *now, TimeUnits units_changed )
+{
+  invalid_time = *now;
+  invalid_units |= units_changed;
+  invalidate_now( INVALID_ROWS );
+}
+
+static void mark_status_dirty( void )
+{
+  invalidate( INVALID_STATUS );
+}
+
+static void toggle_view_setting( int storage_key, bool *value )
+{
+  TRACE_ARGS( TRACE_TOGGLE_VIEW, storage_key, !(*value) )
 
   (*value) = !(*value);
 
-  layer_set_hidden( layer , !(*value) );
   persist_write_bool( storage_key, *value );
+  invalidate( INVALID_VIEWS );
 }
 
 
@@ -562,38 +1051,53 @@ static void load_fontset( FontsetId font_set, bool unload_last )
 {
   if( unload_last )
   {
-    fonts_unload_custom_font( font_hour );
-    fonts_unload_custom_font( font_minutes );
-    fonts_unload_custom_font( font_uhr );
-    fonts_unload_custom_font( font_date );
-    fonts_unload_custom_font( font_charge );
+    unload_font( font_hour );
+    unload_font( font_minutes );
+    unload_font( font_uhr );
+    unload_font( font_date );
   }
 
   switch( font_set )
   {
     case FONT_SET_ITALIC:
       {
-        font_hour    = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_BOLDITALIC_35 ) );
-        font_minutes = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_ITALIC_33 ) );
-        font_uhr     = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_LIGHTITALIC_30 ) );
-        font_date    = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_ITALIC_13 ) );
-        font_charge  = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_REGULAR_9 ) );
+        font_hour    = load_font( RESOURCE_ID_FONT_ROBOTO_BOLDITALIC_35 );
+        font_minutes = load_font( RESOURCE_ID_FONT_ROBOTO_ITALIC_33 );
+        font_uhr     = load_font( RESOURCE_ID_FONT_ROBOTO_LIGHTITALIC_30 );
+        font_date    = load_font( RESOURCE_ID_FONT_ROBOTO_ITALIC_13 );
       }
       break;
 
     case FONT_SET_REGULAR: /* FALL_THROUGH */
     default:
       {
-        font_hour    = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_BOLD_35 ) );
-        font_minutes = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_REGULAR_32 ) );
-        font_uhr     = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_LIGHT_30 ) );
-        font_date    = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_REGULAR_13 ) );
-        font_charge  = fonts_load_custom_font( resource_get_handle( RESOURCE_ID_FONT_ROBOTO_REGULAR_9 ) );
+        font_hour    = load_font( RESOURCE_ID_FONT_ROBOTO_BOLD_35 );
+        font_minutes = load_font( RESOURCE_ID_FONT_ROBOTO_REGULAR_32 );
+        font_uhr     = load_font( RESOURCE_ID_FONT_ROBOTO_LIGHT_30 );
+        font_date    = load_font( RESOURCE_ID_FONT_ROBOTO_REGULAR_13 );
       }
       break;
   }
 }
 
+static void set_row_fonts( void )
+{
+  GFont font_map[] = {
+    font_date,
+    font_hour,
+    font_uhr,
+    font_minutes,
+    font_minutes
+  };
+  int i;
+
+  for( i = 0; i < NUM_ROWS; ++i )
+  {
+    movie_text_layer_set_font( row[i], font_map[i] );
+    layer_mark_dirty( movie_text_layer_get_layer( row[i] ) );
+  }
+}
+
 //
 // Eventbearbeitung
 //
@@ -602,18 +1106,34 @@ static void load_fontset( FontsetId font_set, bool unload_last )
 
 static void on_test_date_tick( void *data __attribute__((__unused__)) )
 {
-  update_rows();
+  struct tm* now = localtime( &test_dates[test_date_pos++] );
+
+  if( test_date_pos > 10 )
+  {
+    test_date_pos = 0;
+  }
+
+  invalidate_rows_now( now, UPDATE_ALL_UNITS );
   test_date_timer = app_timer_register( 5000, on_test_date_tick, NULL );
+
+  STACK_CHECK( STACK_PROBE_TICK )
 }
 
 #else
 
-static void on_minute_tick( struct tm *time_ticks __attribute__((__unused__)),
-                            TimeUnits units_changed __attribute__((__unused__)) )
+static void on_minute_tick( struct tm *time_ticks, TimeUnits units_changed )
 {
-  TRACE
+  TRACE_ARGS( TRACE_MINUTE_TICK, units_changed, 0 )
+
+  if( units_changed & HOUR_UNIT )
+  {
+    telemetry_sample( (uint32_t)time( NULL ) );
+  }
 
-  update_rows();
+  // ein vorbereiteter Plan wird in on_invalidate() übernommen
+  invalidate_rows_now( time_ticks, units_changed );
+
+  STACK_CHECK( STACK_PROBE_TICK )
 }
 
 #endif
@@ -621,7 +1141,7 @@ static void on_minute_tick( struct tm *time_ticks __attribute__((__unused__)),
 static void app_config_send_keys( void );
 static void on_tap_gesture( AccelAxisType axis, int32_t direction )
 {
-  TRACE
+  TRACE_ARGS( TRACE_TAP_GESTURE, axis, 0 )
 
   switch( axis )
   {
@@ -631,185 +1151,413 @@ static void on_tap_gesture( AccelAxisType axis, int32_t direction )
 
     case ACCEL_AXIS_Y:
       APP_DBG( "on_tap_gesture( Y, %ld );", direction );
-      toggle_view_setting( status_layer, SETTINGS_STATUS_VISIBLE, &settings_status_visible );
+      toggle_view_setting( SETTINGS_STATUS_VISIBLE, &settings_status_visible );
       break;
 
     case ACCEL_AXIS_Z:
       APP_DBG( "on_tap_gesture( Z, %ld );", direction );
-      toggle_view_setting( inverter_layer_get_layer( inverter_layer ), 
-                           SETTINGS_INVERTER_STATE, &settings_inverter_state );
+      toggle_view_setting( SETTINGS_INVERTER_STATE, &settings_inverter_state );
       break;
   }
   app_config_send_keys();
+
+  STACK_CHECK( STACK_PROBE_TAP )
 }
 
 static void on_tap_timeout( void *data __attribute__((__unused__)) )
 {
-  TRACE
+  TRACE( TRACE_TAP_TIMEOUT )
 
+  accel_config_timer = 0;
   accel_tap_service_unsubscribe();
 }
 
 static void on_battery_change( BatteryChargeState charge )
 {
-  TRACE
+  TRACE_ARGS( TRACE_BATTERY_CHANGE, charge.charge_percent, charge.is_charging )
   
-  if( settings_status_visible )
+  telemetry_battery( charge );
+
+  // nur neu zeichnen wenn sich die Anzeige ändert
+  if( charge.charge_percent != status_battery_charge.charge_percent ||
+      charge.is_charging != status_battery_charge.is_charging )
   {
     status_battery_charge = charge;
-    layer_mark_dirty( status_layer );
+    mark_status_dirty();
   }
+  else
+  {
+    ++events_suppressed.battery;
+  }
+
+  // einmal beim Unterschreiten, erst über BATTERY_ALERT_REARM wieder
   if( !charge.is_charging && 
-       charge.charge_percent == 10 &&
+       charge.charge_percent <= BATTERY_ALERT_LEVEL &&
        status_battery_did_notify == false)
   {
     status_battery_did_notify = true;
     vibes_short_pulse();
   }
-  if( charge.charge_percent > 10 )
+  if( charge.charge_percent > BATTERY_ALERT_REARM )
   {
     status_battery_did_notify = false;
   }
+
+  STACK_CHECK( STACK_PROBE_BATTERY )
+}
+
+static void on_bluetooth_alert( void *data __attribute__((__unused__)) )
+{
+  TRACE_ARGS( TRACE_BLUETOOTH_CHANGE, false, events_suppressed.bluetooth )
+
+  // Verbindung blieb BT_ALERT_DELAY_MS weg
+  bt_alert_timer = 0;
+  status_bluetooth_conn = false;
+  mark_status_dirty();
+  vibes_double_pulse();
 }
 
 static void on_bluetooth_change( bool connected )
 {
-  TRACE
+  TRACE_ARGS( TRACE_BLUETOOTH_CHANGE, connected, events_suppressed.bluetooth )
 
-  if( settings_status_visible )
+  if( !connected )
   {
-    status_bluetooth_conn = connected;
-    layer_mark_dirty( status_layer );
+    telemetry_count( TELEMETRY_BT_FLAP );
   }
-  if( !connected )
+
+  if( bt_alert_timer )
   {
-    vibes_double_pulse();
+    // Wackler: wieder da bevor der Alarm kam
+    if( connected )
+    {
+      app_timer_cancel( bt_alert_timer );
+      bt_alert_timer = 0;
+    }
+    ++events_suppressed.bluetooth;
   }
+  else if( connected == status_bluetooth_conn )
+  {
+    ++events_suppressed.bluetooth;
+  }
+  else if( connected )
+  {
+    status_bluetooth_conn = true;
+    mark_status_dirty();
+  }
+  else
+  {
+    bt_alert_timer = app_timer_register( BT_ALERT_DELAY_MS, on_bluetooth_alert, NULL );
+  }
+
+  STACK_CHECK( STACK_PROBE_BLUETOOTH )
 }
 
 //
 // Remote-Konfiguration
 //
 
-static void on_conf_keys_changed( const uint32_t key, const Tuple *tp_new,
-                                  const Tuple *tp_old,
-                                  void *ctx __attribute__((__unused__)) )
+static void on_setting_received( SettingsField field, uint8_t value_new )
 {
-  TRACE
+  TRACE_ARGS( TRACE_CONF_KEY_CHANGED, field, value_new )
 
-  bool value = (bool)tp_new->value->uint8;
+  bool value = (bool)value_new;
 
-  switch( key )
+  switch( field )
   {
-    case SETTINGS_INVERTER_STATE: /* FALL_THROUGH */
+    case SETTING_INVERTER_STATE:
       {
-        settings_inverter_state = !value;
-        toggle_view_setting( inverter_layer_get_layer( inverter_layer ),
-                             SETTINGS_INVERTER_STATE, 
-                             &settings_inverter_state );
+        if( value != settings_inverter_state )
+        {
+          toggle_view_setting( SETTINGS_INVERTER_STATE, &settings_inverter_state );
+        }
       }
       break;
 
-    case SETTINGS_STATUS_VISIBLE:
+    case SETTING_STATUS_VISIBLE:
       {
-        settings_status_visible = !value;
-        toggle_view_setting( status_layer, 
-                             SETTINGS_STATUS_VISIBLE,
-                             &settings_status_visible );
+        if( value != settings_status_visible )
+        {
+          toggle_view_setting( SETTINGS_STATUS_VISIBLE, &settings_status_visible );
+        }
       }
       break;
 
-    case SETTINGS_ACCEL_CONFIG:
+    case SETTING_ACCEL_CONFIG:
       {
+        if( value == settings_accel_config )
+        {
+          break;
+        }
+
         settings_accel_config = value;
         persist_write_bool( SETTINGS_ACCEL_CONFIG, settings_accel_config );
       }
       break;
 
-    case SETTINGS_REGULAR_FONTSET:
+    case SETTING_REGULAR_FONTSET:
       {
+        if( value == settings_regular_fontset )
+        {
+          break;
+        }
+
         settings_regular_fontset = value;
         persist_write_bool( SETTINGS_REGULAR_FONTSET, settings_regular_fontset );
 
+        // kommt erst nach STARTUP_MESSAGES, das Fontset ist also geladen
         load_fontset( settings_regular_fontset ? FONT_SET_REGULAR : FONT_SET_ITALIC, true );
+        set_row_fonts();
 
-        movie_text_layer_set_font( row[0], font_date );
-        movie_text_layer_set_font( row[1], font_hour );
-        movie_text_layer_set_font( row[2], font_uhr );
-        movie_text_layer_set_font( row[3], font_minutes );
-        movie_text_layer_set_font( row[4], font_minutes );
+        // die vorbereitete Minute hat die Positionen des alten Fontsets
+        row_next_prepared = false;
+        if( prepare_timer )
+        {
+          app_timer_cancel( prepare_timer );
+          prepare_timer = 0;
+        }
 
-        update_rows();
+        int32_t time_val = time( NULL );
+        invalidate_rows( localtime( &time_val ), UPDATE_ALL_UNITS );
       }
       break;
 
-    case SETTINGS_SEND_KEYS:
+    default:
+      break;
+  }
+}
+
+static void on_conf_key_received( const Tuple *tp_new )
+{
+  switch( tp_new->key )
+  {
+    case SETTINGS_RECORD:
       {
-        if( tp_old && tp_new && tp_new->value->uint8 != tp_old->value->uint8 )
+        SettingsRecord record;
+        uint8_t f;
+
+        if( !settings_record_unpack( &record, tp_new->value->data, tp_new->length ) )
+        {
+          APP_LOG( APP_LOG_LEVEL_WARNING, "Settings record rejected (%u bytes, version %u)",
+                   (unsigned)tp_new->length, tp_new->length ? tp_new->value->data[0] : 0 );
+          break;
+        }
+
+        for( f = 0; f < SETTING_COUNT; ++f )
         {
-          /* Kein echter Config-Wert sondern ein Trigger vom Pebble-JS teil */
-          APP_LOG( APP_LOG_LEVEL_INFO, "Config-Request from JS-Kit [%d]", tp_new->value->uint8 );
-          app_config_send_keys();
+          on_setting_received( f, record.value[f] );
         }
       }
       break;
+
+    case SETTINGS_SEND_KEYS:
+      {
+        /* Kein echter Config-Wert sondern ein Trigger vom Pebble-JS teil */
+        APP_LOG( APP_LOG_LEVEL_INFO, "Config-Request from JS-Kit" );
+        app_config_send_keys();
+      }
+      break;
+
+    case SETTINGS_TRACE_DUMP:
+      {
+        /* Trigger vom Pebble-JS teil, Trace-Ring senden */
+        trace_drain();
+      }
+      break;
+
+    case SETTINGS_TELEMETRY:
+      {
+        /* Telefon schickt den Zeitstempel des letzten Werts den es hat */
+        telemetry_send( tp_new->value->uint32 );
+      }
+      break;
   }
 }
-static void on_app_message_error( DictionaryResult dict_error,
-                                  AppMessageResult app_message_error,
-                                  void* ctx __attribute__((__unused__)) )
+
+static void on_app_message_received( DictionaryIterator *it,
+                                     void *ctx __attribute__((__unused__)) )
 {
-  TRACE
+  Tuple *tp;
+
+  for( tp = dict_read_first( it ); tp != NULL; tp = dict_read_next( it ) )
+  {
+    on_conf_key_received( tp );
+  }
 
-  APP_LOG( APP_LOG_LEVEL_ERROR, "App error: %d / %d", dict_error, app_message_error );
+  STACK_CHECK( STACK_PROBE_MESSAGE )
 }
 
 static void app_config_send_keys( void )
 {
-  TRACE
+  TRACE( TRACE_CONFIG_SEND_KEYS )
 
-  DictionaryIterator* it = NULL;
-  app_message_outbox_begin( &it );
+  DictionaryIterator* it = msg_session_begin();
 
   if( it == NULL )
   {
     return;
   }
 
-  dict_write_uint8( it, SETTINGS_INVERTER_STATE , ( settings_inverter_state  ? 1 : 0 ) );
-  dict_write_uint8( it, SETTINGS_STATUS_VISIBLE , ( settings_status_visible  ? 1 : 0 ) );
-  dict_write_uint8( it, SETTINGS_ACCEL_CONFIG   , ( settings_accel_config    ? 1 : 0 ) );
-  dict_write_uint8( it, SETTINGS_REGULAR_FONTSET, ( settings_regular_fontset ? 1 : 0 ) );
+  SettingsRecord record;
+  uint8_t data[SETTINGS_RECORD_SIZE];
+
+  record.value[SETTING_INVERTER_STATE]  = ( settings_inverter_state  ? 1 : 0 );
+  record.value[SETTING_STATUS_VISIBLE]  = ( settings_status_visible  ? 1 : 0 );
+  record.value[SETTING_ACCEL_CONFIG]    = ( settings_accel_config    ? 1 : 0 );
+  record.value[SETTING_REGULAR_FONTSET] = ( settings_regular_fontset ? 1 : 0 );
+
+  settings_record_pack( &record, data );
+  dict_write_data( it, SETTINGS_RECORD, data, SETTINGS_RECORD_SIZE );
 
   dict_write_end( it );
-  app_message_outbox_send();
+  msg_session_send();
 }
 
 static void app_config_init( void )
 {
-  TRACE
+  TRACE( TRACE_CONFIG_INIT )
 
-  Tuplet persistent_keys[] = {
-    TupletInteger( SETTINGS_INVERTER_STATE , ( settings_inverter_state  ? 1 : 0 ) ),
-    TupletInteger( SETTINGS_STATUS_VISIBLE , ( settings_status_visible  ? 1 : 0 ) ),
-    TupletInteger( SETTINGS_ACCEL_CONFIG   , ( settings_accel_config    ? 1 : 0 ) ),
-    TupletInteger( SETTINGS_REGULAR_FONTSET, ( settings_regular_fontset ? 1 : 0 ) ),
-    TupletInteger( SETTINGS_SEND_KEYS      , 0 ),
-  };
-
-  app_message_open( 92,92 );
-  app_sync_init( &app, appsync_buffer, sizeof( appsync_buffer ), 
-                 persistent_keys, ARRAY_LENGTH( persistent_keys ),
-                 on_conf_keys_changed, on_app_message_error, NULL );
+  trace_init( SETTINGS_TRACE_DUMP );
 
-  app_config_send_keys();
+  // Einstellungen holt sich das Telefon selbst (SETTINGS_SEND_KEYS)
+  msg_session_init( on_app_message_received );
 }
 
 static void app_config_deinit( void )
 {
-  TRACE
+  TRACE( TRACE_CONFIG_DEINIT )
+
+  msg_session_deinit();
+}
+
+//
+// Start in Stufen
+//
+// init() legt nur das Fenster an, die Zeilen bleiben versteckt: ihre
+// Positionen passen nur zum Fontset, mit Systemfonts würden sie beim
+// Tausch springen. Sobald das erste Bild gezeichnet ist, folgen Fontset
+// (jetzt laufen die Zeilen ein), Statusbalken und AppMessage, je ein
+// Schritt pro Timer. startup_probe merkt sich das erste Bild und das erste
+// mit allem drin und reicht den nächsten Schritt per Timer nach, aus dem
+// Zeichnen heraus wird nichts umgeplant.
+//
+
+static uint16_t startup_elapsed_ms( void )
+{
+  time_t sec;
+  uint16_t ms;
+
+  time_ms( &sec, &ms );
+
+  int32_t elapsed = ( sec - startup_sec ) * 1000 + ms - startup_ms;
+
+  return elapsed < UINT16_MAX ? (uint16_t)elapsed : UINT16_MAX;
+}
+
+static void startup_reached( StartupStage stage )
+{
+  uint16_t elapsed __attribute__((__unused__)) = startup_elapsed_ms();  // nur Trace und Log
+
+  startup_stage = stage;
+
+  TRACE_ARGS( TRACE_STARTUP, stage, elapsed )
+  APP_DBG( "startup: stage %d after %u ms", stage, elapsed );
+}
+
+static void on_startup_step( void *data __attribute__((__unused__)) )
+{
+  startup_timer = 0;
+
+  switch( startup_stage )
+  {
+    case STARTUP_SYSTEM_FONTS:  // STARTUP_FRAME_TIMEOUT_MS ohne Bild
+    case STARTUP_FIRST_FRAME:
+      {
+        int32_t time_val = time( NULL );
+        int i;
+
+        if( startup_timeout )
+        {
+          app_timer_cancel( startup_timeout );
+          startup_timeout = 0;
+        }
+
+        load_fontset( settings_regular_fontset ? FONT_SET_REGULAR : FONT_SET_ITALIC, false );
+        set_row_fonts();
+        startup_reached( STARTUP_CUSTOM_FONTS );
+
+        // nicht auf den ersten Tick warten, die Zeilen laufen gleich mit
+        // dem Fontset ein
+        for( i = 0; i < NUM_ROWS; ++i )
+        {
+          layer_set_hidden( movie_text_layer_get_layer( row[i] ), false );
+        }
+        update_rows( localtime( &time_val ), UPDATE_ALL_UNITS );
+      }
+      break;
+
+    case STARTUP_CUSTOM_FONTS:
+      {
+        // window_load() hat ihn bis hierher versteckt
+        if( settings_status_visible )
+        {
+          status_res_load();
+          layer_set_hidden( status_layer, false );
+        }
+        startup_reached( STARTUP_STATUS );
+      }
+      break;
+
+    case STARTUP_STATUS:
+      {
+        app_config_init();
+        startup_reached( STARTUP_MESSAGES );
+
+        // STARTUP_FINAL_FRAME meldet das nächste Bild
+        layer_mark_dirty( startup_probe );
+      }
+      return;
+
+    case STARTUP_FINAL_FRAME:
+      {
+        // gemessen, die Probe wird nicht mehr gebraucht
+        layer_remove_from_parent( startup_probe );
+        layer_destroy( ui_arena_take( startup_probe ) );
+        startup_probe = 0;
+      }
+      return;
+
+    default:
+      return;
+  }
+
+  startup_timer = app_timer_register( STARTUP_STEP_MS, on_startup_step, NULL );
+}
+
+// verdeckt gestartet: ohne erstes Bild trotzdem weiter
+static void on_startup_timeout( void *data __attribute__((__unused__)) )
+{
+  startup_timeout = 0;
+
+  if( startup_stage == STARTUP_SYSTEM_FONTS )
+  {
+    on_startup_step( NULL );
+  }
+}
 
-  app_sync_deinit( &app );
+static void draw_startup_probe( Layer *layer __attribute__((__unused__)),
+                                GContext *ctx __attribute__((__unused__)) )
+{
+  if( startup_stage == STARTUP_SYSTEM_FONTS )
+  {
+    startup_reached( STARTUP_FIRST_FRAME );
+    startup_timer = app_timer_register( STARTUP_STEP_MS, on_startup_step, NULL );
+  }
+  else if( startup_stage == STARTUP_MESSAGES )
+  {
+    startup_reached( STARTUP_FINAL_FRAME );
+    startup_timer = app_timer_register( 0, on_startup_step, NULL );
+  }
 }
 
 //
@@ -819,7 +1567,7 @@ static void app_config_deinit( void )
 
 static void window_load(Window *window)
 {
-  TRACE
+  TRACE( TRACE_WINDOW_LOAD )
 
   int i; // immer gut ein 'i' zu haben
   
@@ -828,37 +1576,45 @@ static void window_load(Window *window)
   GRect row_frame = GRect( 0, 0, SCREEN_WIDTH, ROW_MAX_HIGHT );
   GRect status_bar_rect = GRect( 0, 0, SCREEN_WIDTH, 20 );
 
-  // Datumszeilen
-  GFont font_map[] = {
-    font_date,
-    font_hour,
-    font_uhr,
-    font_minutes,
-    font_minutes
-  };
+  // unter allem anderen, wird nach dem Start wieder entfernt
+  if( startup_stage < STARTUP_FINAL_FRAME )
+  {
+    startup_probe = ui_arena_put( UI_ARENA_LAYER, layer_create( window_frame ) );
+    layer_set_update_proc( startup_probe, draw_startup_probe );
+    layer_add_child( window_layer, startup_probe );
+  }
 
+  // Datumszeilen
   for( i = 0; i < NUM_ROWS; ++i )
   {
-    row[i] = movie_text_layer_create( row_frame.origin, ROW_STD_HIGHT );
+    row[i] = ui_arena_put( UI_ARENA_MOVIE_TEXT,
+                           movie_text_layer_create( row_frame.origin, ROW_STD_HIGHT ) );
 
     movie_text_layer_set_text_color( row[i], GColorWhite );
     movie_text_layer_set_background_color( row[i], GColorClear );
-    movie_text_layer_set_font( row[i], font_map[i] );
 
+    // bis zum Fontset versteckt (on_startup_step)
+    layer_set_hidden( movie_text_layer_get_layer( row[i] ), startup_stage < STARTUP_CUSTOM_FONTS );
     layer_add_child( window_layer, movie_text_layer_get_layer( row[i] ) );
   }
+  set_row_fonts();
 
   // Inverter, Statusbalken & Ladezustandslayer  
-  status_layer = layer_create( status_bar_rect );  
-  charge_layer = inverter_layer_create( GRectZero );
+  status_layer = ui_arena_put( UI_ARENA_LAYER, layer_create( status_bar_rect ) );
+
+  // beim Start erst in STARTUP_STATUS
+  bool status_shown = settings_status_visible && startup_stage >= STARTUP_STATUS;
 
   layer_set_update_proc( status_layer, update_status );
-  layer_set_hidden( status_layer, !settings_status_visible );
-  layer_add_child( status_layer, inverter_layer_get_layer( charge_layer ) );
+  layer_set_hidden( status_layer, !status_shown );
   layer_add_child( window_layer, status_layer );
+  if( status_shown )
+  {
+    status_res_load();
+  }
 
   // Inverter als letztes (und somit kein layer_insert_below_sibling calls)
-  inverter_layer = inverter_layer_create( window_frame );
+  inverter_layer = ui_arena_put( UI_ARENA_INVERTER, inverter_layer_create( window_frame ) );
   layer_set_hidden( inverter_layer_get_layer( inverter_layer), !settings_inverter_state );
   layer_add_child( window_layer, inverter_layer_get_layer( inverter_layer ) );
 
@@ -876,40 +1632,67 @@ static void window_load(Window *window)
 #else
   tick_timer_service_subscribe( MINUTE_UNIT, on_minute_tick );
 #endif
+
+  // ab hier werden keine Objekte mehr angelegt, außer dem Statusbalken
+  // (und beim Start dem Fontset)
+  ui_arena_seal( ( status_res_loaded ? 0 : STATUS_RES_OBJECTS ) +
+                 ( startup_stage >= STARTUP_CUSTOM_FONTS ? 0 : FONTSET_OBJECTS ) );
 }
 
 static void window_unload(Window *window)
 {
-  TRACE
+  TRACE( TRACE_WINDOW_UNLOAD )
 
   int i;
 
-  inverter_layer_destroy( inverter_layer );
-  inverter_layer_destroy( charge_layer );
-  layer_destroy( status_layer );
+  if( invalidate_timer )
+  {
+    app_timer_cancel( invalidate_timer );
+    invalidate_timer = 0;
+    invalid_flags = 0;
+    invalid_units = 0;
+  }
+
+  if( prepare_timer )
+  {
+    app_timer_cancel( prepare_timer );
+    prepare_timer = 0;
+  }
+  row_next_prepared = false;
+
+  if( startup_probe )
+  {
+    layer_destroy( ui_arena_take( startup_probe ) );
+    startup_probe = 0;
+  }
+
+  inverter_layer_destroy( ui_arena_take( inverter_layer ) );
+  status_res_unload();
+  layer_destroy( ui_arena_take( status_layer ) );
 
   for( i = 0; i < NUM_ROWS; ++i )
   {
     if( row[i] != NULL )
     {
-      movie_text_layer_destroy( row[i] );
+      movie_text_layer_destroy( ui_arena_take( row[i] ) );
       row[i] = NULL;
     }
   }
 
-  fonts_unload_custom_font( font_hour );
-  fonts_unload_custom_font( font_minutes );
-  fonts_unload_custom_font( font_date );
-  fonts_unload_custom_font( font_uhr );
-  fonts_unload_custom_font( font_charge );
-
-  gbitmap_destroy( icon_bt_on );
-  gbitmap_destroy( icon_bt_off );
+#if DEBUG
+  ui_arena_log();
+  APP_DBG( "suppressed: %u bluetooth / %u battery",
+           events_suppressed.bluetooth, events_suppressed.battery );
+  APP_DBG( "invalidate: %u events / %u passes",
+           invalidate_stats.events, invalidate_stats.passes );
+#endif
 }
 
 static void init(void)
 {
-  TRACE
+  TRACE( TRACE_INIT )
+
+  time_ms( &startup_sec, &startup_ms );
 
   first_update = 1;
   if( persist_exists( SETTINGS_INVERTER_STATE ) )
@@ -941,44 +1724,85 @@ static void init(void)
     .unload = window_unload,
   });
 
-  load_fontset( settings_regular_fontset ? FONT_SET_REGULAR : FONT_SET_ITALIC, false );
+  // Fontset erst nach dem ersten Bild (on_startup_step), bis dahin sind
+  // die Zeilen versteckt
+  font_hour    = fonts_get_system_font( FONT_KEY_GOTHIC_28_BOLD );
+  font_minutes = fonts_get_system_font( FONT_KEY_GOTHIC_28 );
+  font_uhr     = fonts_get_system_font( FONT_KEY_GOTHIC_28 );
+  font_date    = fonts_get_system_font( FONT_KEY_GOTHIC_14 );
 
-  icon_bt_on  = gbitmap_create_with_resource( RESOURCE_ID_IMAGE_BT_ON_ICON );
-  icon_bt_off = gbitmap_create_with_resource( RESOURCE_ID_IMAGE_BT_OFF_ICON );
-
-  memset( row_cur_data, 0, sizeof( row_cur_data ) );
-  memset( row_cur_pos, 0, sizeof( row_cur_pos ) );
-  memset( row_old_pos, 0, sizeof( row_old_pos ) );
+  memset( &row_cur, 0, sizeof( row_cur ) );
+  memset( row_shown_key, 0, sizeof( row_shown_key ) );
 
   status_battery_charge = battery_state_service_peek();
   status_bluetooth_conn = bluetooth_connection_service_peek();
 
-  app_config_init();
+  telemetry_init( SETTINGS_TELEMETRY, SETTINGS_TELEMETRY_HOUR );
 
-  // als letztes damit alle resourcen initialisiert sind
   window_stack_push( window, true /*animated*/ );
+
+  // normalerweise startet das erste Bild die Stufen (draw_startup_probe)
+  startup_timeout = app_timer_register( STARTUP_FRAME_TIMEOUT_MS, on_startup_timeout, NULL );
 }
 
 static void deinit(void)
 {
-  TRACE
+  TRACE( TRACE_DEINIT )
 
-  app_config_deinit();
+  if( startup_timer )
+  {
+    app_timer_cancel( startup_timer );
+    startup_timer = 0;
+  }
+  if( startup_timeout )
+  {
+    app_timer_cancel( startup_timeout );
+    startup_timeout = 0;
+  }
+
+  if( startup_stage >= STARTUP_MESSAGES )
+  {
+    app_config_deinit();
+  }
+  telemetry_deinit();
 
   accel_tap_service_unsubscribe();
   battery_state_service_unsubscribe();
   bluetooth_connection_service_unsubscribe();
 
+  if( bt_alert_timer )
+  {
+    app_timer_cancel( bt_alert_timer );
+    bt_alert_timer = 0;
+  }
+
 #if !TEST_DATE
   tick_timer_service_unsubscribe();
 #endif
 
   window_destroy( window );
+
+  // in on_startup_step() geladen, nicht in window_load
+  if( startup_stage >= STARTUP_CUSTOM_FONTS )
+  {
+    unload_font( font_hour );
+    unload_font( font_minutes );
+    unload_font( font_date );
+    unload_font( font_uhr );
+  }
+
+#if STACK_PROBE
+  stack_probe_log();
+#endif
 }
 
 int main(void) 
 {
-  TRACE
+  TRACE( TRACE_MAIN )
+
+#if STACK_PROBE
+  stack_probe_init();
+#endif
 
   init();
   app_event_loop();
@@ -0,0 +1,100 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /digit_label.c, created 2026-10-19 / */
+
+#include "digit_label.h"
+#include "digit_sprites.h"
+
+static int8_t _glyph( char c )
+{
+  const char* glyphs = DIGIT_SPRITES_GLYPHS;
+  int8_t i;
+
+  for( i = 0; glyphs[i] != '\0'; ++i )
+  {
+    if( glyphs[i] == c )
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+uint8_t digit_label_draw( GContext* ctx, GBitmap* sheet, const char* text, GRect box )
+{
+  GRect sheet_bounds;
+  const char* c;
+  int16_t width = 0, x, y;
+  int8_t g, last = -1;
+  uint8_t blits = 0;
+
+  if( sheet == NULL || text == NULL )
+  {
+    return 0;
+  }
+
+  for( c = text; *c != '\0'; ++c )
+  {
+    if( ( g = _glyph( *c ) ) >= 0 )
+    {
+      width += DIGIT_SPRITES[g].advance;
+      last = g;
+    }
+  }
+  if( last < 0 )
+  {
+    return 0;
+  }
+  // no gap after the last glyph
+  width -= DIGIT_SPRITES[last].advance - DIGIT_SPRITES[last].w;
+
+  x = box.origin.x + ( box.size.w - width ) / 2;
+  y = box.origin.y + ( box.size.h - DIGIT_SPRITES_HEIGHT ) / 2;
+
+  // one bitmap for all glyphs, the source rect is selected via bounds
+  sheet_bounds = sheet->bounds;
+  graphics_context_set_compositing_mode( ctx, GCompOpOr );
+
+  for( c = text; *c != '\0'; ++c )
+  {
+    if( ( g = _glyph( *c ) ) < 0 )
+    {
+      continue;
+    }
+
+    sheet->bounds = GRect( DIGIT_SPRITES[g].x, 0, DIGIT_SPRITES[g].w, DIGIT_SPRITES_HEIGHT );
+    graphics_draw_bitmap_in_rect( ctx, sheet,
+                                  GRect( x, y, DIGIT_SPRITES[g].w, DIGIT_SPRITES_HEIGHT ) );
+    x += DIGIT_SPRITES[g].advance;
+    ++blits;
+  }
+
+  sheet->bounds = sheet_bounds;
+  graphics_context_set_compositing_mode( ctx, GCompOpAssign );
+
+  return blits;
+}
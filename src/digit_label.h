@@ -0,0 +1,47 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /digit_label.h, created 2026-10-19 / */
+
+#ifndef __DIGIT_LABEL_H
+#define __DIGIT_LABEL_H
+
+#include <pebble.h>
+
+// Battery label drawn from a pre-rendered digit sprite sheet instead of a
+// custom font. The sheet (resources/images/battery_digits.png) and its
+// glyph table (digit_sprites.h) are rendered from Roboto-Regular_9.ttf and
+// checked in; after changing the font or the size regenerate both by hand
+// and commit them:
+//
+//   python tools/digit_sprites.py resources/fonts/roboto/Roboto-Regular_9.ttf 9
+//          resources/images/battery_digits.png src/digit_sprites.h
+
+// Draws 'text' ("0-9 % + .", other characters are skipped) centered in
+// 'box' with set pixels only; returns the number of blits.
+uint8_t digit_label_draw( GContext* ctx, GBitmap* sheet, const char* text, GRect box );
+
+#endif
@@ -0,0 +1,26 @@
+// generated by tools/digit_sprites.py from Roboto-Regular_9.ttf (9px), do not edit
+
+#ifndef __DIGIT_SPRITES_H
+#define __DIGIT_SPRITES_H
+
+#define DIGIT_SPRITES_GLYPHS "0123456789%+."
+#define DIGIT_SPRITES_HEIGHT 6
+
+// x / width in the sheet, advance to the next glyph
+static const struct { uint8_t x, w, advance; } DIGIT_SPRITES[] = {
+  {   0,  4,  5 },  // '0'
+  {   4,  2,  5 },  // '1'
+  {   6,  4,  5 },  // '2'
+  {  10,  4,  5 },  // '3'
+  {  14,  4,  5 },  // '4'
+  {  18,  4,  5 },  // '5'
+  {  22,  4,  5 },  // '6'
+  {  26,  4,  5 },  // '7'
+  {  30,  4,  5 },  // '8'
+  {  34,  4,  5 },  // '9'
+  {  38,  6,  7 },  // '%'
+  {  44,  3,  5 },  // '+'
+  {  47,  1,  2 },  // '.'
+};
+
+#endif
@@ -1,13 +1,76 @@
+/* settings record layout from src/settings_schema.h (tools/settings_schema.py) */
+var SETTINGS_SCHEMA = "@SETTINGS_SCHEMA@";
+
+/* watch defaults, used until the watch reported its settings once */
 var config = {};
-var got_config = false;
-var show_config = false;
+SETTINGS_SCHEMA.fields.forEach( function( field ) {
+	config[field.name] = field['default'];
+} );
 
-function showConfigWindow()
+/* src/js/web inlined by tools/inline_config.py (wscript) */
+var CONFIG_PAGE_URI = "@CONFIG_PAGE_URI@";
+var CONFIG_REMOTE_URI = 'http://pebble.bitspin.at/config/Filmplakat2/';
+
+function storeConfig( data )
 {
-	var uri_params = config;
-	uri_params['nonce'] = new Date().getTime();
+	var key;
+
+	for( key in config ) {
+		if( data[key] !== undefined ) {
+			config[key] = data[key] | 0;
+		}
+	}
+	window.localStorage.setItem( "filmplakat2", JSON.stringify( config ) );
+}
+
+/* settings <-> record: version byte, then the fields LSB first */
+function encodeSettings( settings )
+{
+	var bytes = [ SETTINGS_SCHEMA.version ];
+	var bit = 0;
+
+	SETTINGS_SCHEMA.fields.forEach( function( field ) {
+		var b;
+
+		for( b = 0; b < field.bits; ++b, ++bit ) {
+			if( ( bit % 8 ) === 0 ) {
+				bytes.push( 0 );
+			}
+			if( settings[field.name] & ( 1 << b ) ) {
+				bytes[1 + ( bit >> 3 )] |= ( 1 << ( bit % 8 ) );
+			}
+		}
+	} );
+	return bytes;
+}
 
-	var uri = 'http://pebble.bitspin.at/config/Filmplakat2/#' + encodeURIComponent( JSON.stringify( uri_params ) );
+function decodeSettings( bytes )
+{
+	var settings = {};
+	var bit = 0;
+
+	if( bytes.length < 1 || bytes[0] !== SETTINGS_SCHEMA.version ) {
+		console.log( "Settings record with version " + bytes[0] + " ignored" );
+		return null;
+	}
+
+	SETTINGS_SCHEMA.fields.forEach( function( field ) {
+		var b;
+
+		settings[field.name] = 0;
+		for( b = 0; b < field.bits; ++b, ++bit ) {
+			if( bytes[1 + ( bit >> 3 )] & ( 1 << ( bit % 8 ) ) ) {
+				settings[field.name] |= ( 1 << b );
+			}
+		}
+	} );
+	return settings;
+}
+
+function showConfigWindow()
+{
+	var page = CONFIG_PAGE_URI.indexOf( 'data:' ) === 0 ? CONFIG_PAGE_URI : CONFIG_REMOTE_URI;
+	var uri = page + '#' + encodeURIComponent( JSON.stringify( config ) );
 	var res;
 
 	//console.log( "Going to openURL: '" + uri + "'" );
@@ -16,27 +79,274 @@ function showConfigWindow()
 	console.log( "openURL returned: " + res );
 }
 
+/* Outgoing messages: one in flight at a time, waiting messages of the
+ * same kind are merged into one (newest values win), nacks are retried
+ * with exponential backoff. */
+var SEND_RETRIES = 5;
+var SEND_BACKOFF_MS = 500;
+var send_queue = [];
+var send_busy = false;
+var send_stats = { sent : 0, merged : 0, retries : 0, failed : 0, latency : 0 };
+
+function queueMessage( kind, payload )
+{
+	var i, key, msg;
+
+	for( i = 0; i < send_queue.length; ++i )
+	{
+		msg = send_queue[i];
+		if( msg.kind === kind && !msg.in_flight )
+		{
+			for( key in payload ) {
+				msg.payload[key] = payload[key];
+			}
+			send_stats.merged++;
+			return;
+		}
+	}
+
+	msg = { kind : kind, payload : {}, tries : 0, queued : Date.now(), in_flight : false };
+	for( key in payload ) {
+		msg.payload[key] = payload[key];
+	}
+	send_queue.push( msg );
+	sendNext();
+}
+
+function sendNext()
+{
+	var msg;
+
+	if( send_busy || send_queue.length === 0 ) {
+		return;
+	}
+
+	msg = send_queue[0];
+	msg.tries++;
+	msg.in_flight = true;
+	send_busy = true;
+
+	Pebble.sendAppMessage( msg.payload,
+		function( e ) {
+			var latency = Date.now() - msg.queued;
+
+			send_queue.shift();
+			send_busy = false;
+			send_stats.sent++;
+			send_stats.latency += latency;
+			console.log( "send[" + msg.kind + "]: ok after " + msg.tries + " tries, " + latency + "ms (" +
+			             send_stats.sent + " sent, " + send_stats.merged + " merged, " +
+			             send_stats.retries + " retries, " + send_stats.failed + " failed, " +
+			             Math.round( send_stats.latency / send_stats.sent ) + "ms avg)" );
+			sendNext();
+		},
+		function( e ) {
+			var i, key, later;
+
+			msg.in_flight = false;
+
+			// a newer message of the same kind is waiting: retry that one
+			for( i = 1; i < send_queue.length; ++i )
+			{
+				later = send_queue[i];
+				if( later.kind === msg.kind )
+				{
+					for( key in msg.payload ) {
+						if( !( key in later.payload ) ) {
+							later.payload[key] = msg.payload[key];
+						}
+					}
+					later.tries = msg.tries;
+					later.queued = msg.queued;
+					send_queue.splice( i, 1 );
+					send_queue[0] = later;
+					send_stats.merged++;
+					msg = later;
+					break;
+				}
+			}
+
+			if( msg.tries > SEND_RETRIES )
+			{
+				console.log( "send[" + msg.kind + "]: giving up after " + msg.tries + " tries" );
+				send_queue.shift();
+				send_busy = false;
+				send_stats.failed++;
+				sendNext();
+				return;
+			}
+
+			// send_busy stays set, the queue waits for this message
+			send_stats.retries++;
+			setTimeout( function() {
+				send_busy = false;
+				sendNext();
+			}, SEND_BACKOFF_MS * Math.pow( 2, msg.tries - 1 ) );
+		}
+	);
+}
+
 Pebble.addEventListener("ready",
 	function( e ) {
 		var data = window.localStorage.getItem( "filmplakat2" );
 		if( typeof( data ) === 'string' ) {
-			config = JSON.parse( data );
+			storeConfig( JSON.parse( data ) );
 			//console.log( "Configuration data: ", data );
 			console.log( "Got config data from localStorage" );
 		}
+
+		requestTelemetry();
 	}
 );
 
+/* TraceEvent names from src/trace.h, filled in by tools/trace_events.py */
+var TRACE_EVENTS = "@TRACE_EVENTS@";
+var TRACE_FORMAT = 1;
+var TRACE_RECORD_SIZE = 8;
+
+function decodeTraceChunk( data )
+{
+	var i, ev, arg0, arg1, ms;
+
+	if( data.length < 2 || data[0] != TRACE_FORMAT )
+	{
+		console.log( "trace: unknown chunk format " + data[0] );
+		return;
+	}
+
+	if( data[1] > 0 )
+	{
+		console.log( "trace: " + data[1] + " records dropped" );
+	}
+
+	for( i = 2; i + TRACE_RECORD_SIZE <= data.length; i += TRACE_RECORD_SIZE )
+	{
+		ev   = data[i];
+		arg0 = data[i + 1];
+		arg1 = data[i + 2] | ( data[i + 3] << 8 );
+		ms   = ( data[i + 4] | ( data[i + 5] << 8 ) | ( data[i + 6] << 16 ) | ( data[i + 7] << 24 ) ) >>> 0;
+
+		console.log( "trace: " + ms + " " + ( TRACE_EVENTS[ev] || ( "#" + ev ) ) + " " + arg0 + " " + arg1 );
+	}
+}
+
+/* must match TelemetrySample in src/telemetry.h */
+var TELEMETRY_FORMAT = 1;
+var TELEMETRY_SAMPLE_SIZE = 12;
+var TELEMETRY_CHARGING = 0x01;
+var TELEMETRY_PARTIAL = 0x02;
+var TELEMETRY_KEEP = 24 * 14;
+
+function loadTelemetry()
+{
+	var data = window.localStorage.getItem( "filmplakat2_telemetry" );
+	var telemetry = { last : 0, samples : [],
+	                  totals : { hours : 0, drain : 0, animations : 0, frames : 0, app_messages : 0, bt_flaps : 0 } };
+
+	if( typeof( data ) === 'string' ) {
+		telemetry = JSON.parse( data );
+	}
+	return telemetry;
+}
+
+function requestTelemetry()
+{
+	queueMessage( 'telemetry', { 'telemetry' : loadTelemetry().last } );
+}
+
+/* Only full, uncharged hours directly following another sample count
+ * towards the totals, the charge drop of such an hour is the face's cost. */
+function addTelemetrySample( telemetry, sample )
+{
+	var prev = telemetry.samples[telemetry.samples.length - 1];
+	var t = telemetry.totals;
+
+	if( prev && sample.time - prev.time <= 3600 + 60 &&
+	    !( sample.flags & ( TELEMETRY_CHARGING | TELEMETRY_PARTIAL ) ) &&
+	    !( prev.flags & TELEMETRY_CHARGING ) )
+	{
+		t.hours        += 1;
+		t.drain        += prev.charge - sample.charge;
+		t.animations   += sample.animations;
+		t.frames       += sample.frames;
+		t.app_messages += sample.app_messages;
+		t.bt_flaps     += sample.bt_flaps;
+	}
+
+	telemetry.samples.push( sample );
+	if( telemetry.samples.length > TELEMETRY_KEEP ) {
+		telemetry.samples.shift();
+	}
+	telemetry.last = sample.time;
+}
+
+function decodeTelemetryChunk( data )
+{
+	var telemetry = loadTelemetry();
+	var i, count, t;
+
+	if( data.length < 2 || data[0] != TELEMETRY_FORMAT )
+	{
+		console.log( "telemetry: unknown chunk format " + data[0] );
+		return;
+	}
+
+	count = data[1];
+	for( i = 2; count > 0 && i + TELEMETRY_SAMPLE_SIZE <= data.length; i += TELEMETRY_SAMPLE_SIZE, --count )
+	{
+		var sample = {
+			time         : ( data[i] | ( data[i + 1] << 8 ) | ( data[i + 2] << 16 ) | ( data[i + 3] << 24 ) ) >>> 0,
+			animations   : data[i + 4] | ( data[i + 5] << 8 ),
+			frames       : data[i + 6] | ( data[i + 7] << 8 ),
+			charge       : data[i + 8],
+			flags        : data[i + 9],
+			app_messages : data[i + 10],
+			bt_flaps     : data[i + 11]
+		};
+
+		if( sample.time > telemetry.last ) {
+			addTelemetrySample( telemetry, sample );
+		}
+	}
+
+	window.localStorage.setItem( "filmplakat2_telemetry", JSON.stringify( telemetry ) );
+
+	t = telemetry.totals;
+	if( t.hours > 0 )
+	{
+		console.log( "telemetry: " + t.hours + "h, " + ( t.drain / t.hours ).toFixed( 2 ) + "%/h, " +
+		             Math.round( t.animations / t.hours ) + " animations/h, " +
+		             Math.round( t.frames / t.hours ) + " frames/h, " +
+		             ( t.app_messages / t.hours ).toFixed( 1 ) + " messages/h, " +
+		             ( t.bt_flaps / t.hours ).toFixed( 2 ) + " bt drops/h" );
+	}
+}
+
 Pebble.addEventListener( "appmessage",
 	function( e ) {
-		console.log( "Got config data from Pebble" );
-		config = e.payload;
-		got_config = true;
+		if( e.payload.trace_dump !== undefined )
+		{
+			decodeTraceChunk( e.payload.trace_dump );
+			return;
+		}
+
+		if( e.payload.telemetry !== undefined )
+		{
+			decodeTelemetryChunk( e.payload.telemetry );
+			return;
+		}
 
-		if( show_config )
+		// settings (reply to settings_send_keys), the next config page
+		// starts from these
+		if( e.payload.settings_record !== undefined )
 		{
-			show_config = false;
-			showConfiguration();
+			var settings = decodeSettings( e.payload.settings_record );
+
+			if( settings !== null )
+			{
+				console.log( "Got config data from Pebble" );
+				storeConfig( settings );
+			}
 		}
 	}
 );
@@ -44,25 +354,18 @@ Pebble.addEventListener( "appmessage",
 Pebble.addEventListener( "webviewclosed",
 	function( e ) {
 		if( typeof e.response === 'string' && ( e.response.length > 0 ) ) {
-			config = JSON.parse( e.response );
 			//console.log( "Update config data: ", e.response );
-
-			window.localStorage.setItem( "filmplakat2", e.response );
-			Pebble.sendAppMessage( config );
+			storeConfig( JSON.parse( decodeURIComponent( e.response ) ) );
+			queueMessage( 'config', { 'settings_record' : encodeSettings( config ) } );
 		}
 	}
 );
 
 Pebble.addEventListener( "showConfiguration",
 	function( e ){
-		if( got_config == false )
-		{
-			show_config = true;
-			Pebble.sendAppMessage( { 'settings_send_keys' : new Date().getTime() } );
-		}
-		else
-		{
-			showConfigWindow();
-		}
+		// open from the cached settings right away, ask the watch for its
+		// current ones in the background (stored for the next time)
+		showConfigWindow();
+		queueMessage( 'send_keys', { 'settings_send_keys' : new Date().getTime() } );
 	}
 );
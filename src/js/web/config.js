@@ -4,6 +4,6 @@ function s(e) {
 	return window.location.href="pebblejs://close#"+JSON.stringify(o),!1
 }
 
-var d=JSON.parse(decodeURIComponent(window.location.hash.substring(1)));
+var d=JSON.parse(decodeURIComponent(window.location.hash.substring(1))||'{}');
 for(var i in d)
-	d.hasOwnProperty(i) && (document.getElementById(i).checked=!!d[i]);
+	d.hasOwnProperty(i) && document.getElementById(i) && (document.getElementById(i).checked=!!d[i]);
@@ -27,22 +27,36 @@
 /* /movie_text_layer.c, created 2013-12-15 / */
 
 #include "movie_text_layer.h"
+#include "stack_probe.h"
+
+#define TEXT_SIZE 20
+
+#define SLIDE_DURATION    500
+#define WIPE_DURATION     250
+#define DISSOLVE_DURATION 300
+#define PUSH_DURATION     200
+#define MOVE_DURATION     1000
+#define START_DELAY       100
+#define FRAME_INTERVAL    33    // animation timer, ~30 fps
 
 typedef struct _MovieTextLayerData
 {
   GFont  font;
   GColor fg, bg;
-  GPoint origin;
+  GPoint origin;                // target origin
 
-  char *buf_r;
-  char buf_l[20];
+  char text[TEXT_SIZE];         // text currently drawn
+  char pending[TEXT_SIZE];      // target text while sliding out
+  GSize text_size;              // content size of text, measured on demand (0: stale)
 
-  bool animating_in;
-  bool animating_out;
-  bool animating_offset;
+  MovieTextState state;
+  MovieTextUpdateMode effect;   // effect of the running / next text change
+  bool delay;
+  bool running;                 // animation started and not yet stopped
 
-  MovieTextUpdateMode animation_mode;
-  PropertyAnimation *animation;
+  Animation *animation;         // created with the layer, reused for every change
+  GRect from, to;               // frame animation (slides, wipe, moves)
+  uint16_t progress;            // drawn effects, 0 .. ANIMATION_NORMALIZED_MAX
 
 } __attribute__((__packed__)) MovieTextLayerData;
 
@@ -51,98 +65,454 @@ typedef struct _MovieTextLayerData
 
 #define SCREEN_WIDTH 144
 
-static void _animation_started( struct Animation* animation, void* context )
+static MovieTextActivity activity = { 0, 0, 0 };
+
+// frames are counted while any layer animates, rows that animate together
+// share their frames
+static uint8_t  running_layers = 0;
+static uint32_t running_since = 0;
+
+//
+// State machine
+//
+// Requests only update the target (data->pending, data->origin) and are
+// then fed as events into one transition table. A request that arrives
+// while an animation is running is merged into that animation instead of
+// cancelling and restarting it (NULL: the target is picked up as is).
+//
+
+typedef enum
+{
+  MovieTextEventText,   // data->pending changed (animated)
+  MovieTextEventMove,   // data->origin changed (animated)
+  MovieTextEventDone,   // running animation finished
+  MovieTextEventCount
+} MovieTextEvent;
+
+typedef void (*MovieTextAction)( Layer* layer, MovieTextLayerData* data );
+
+static void _slide_out( Layer* layer, MovieTextLayerData* data );
+static void _slide_in( Layer* layer, MovieTextLayerData* data );
+static void _move( Layer* layer, MovieTextLayerData* data );
+static void _swap_text( Layer* layer, MovieTextLayerData* data );
+static void _retarget( Layer* layer, MovieTextLayerData* data );
+static void _finish( Layer* layer, MovieTextLayerData* data );
+
+static const MovieTextAction transitions[MovieTextStateCount][MovieTextEventCount] = {
+  //                            Text        Move       Done
+  [MovieTextStateIdle]       = { _slide_out, _move,     NULL      },
+  [MovieTextStateSlidingOut] = { NULL,       NULL,      _slide_in },
+  [MovieTextStateSlidingIn]  = { _swap_text, _retarget, _finish   },
+  [MovieTextStateMoving]     = { _slide_out, _retarget, _finish   },
+};
+
+static void _dispatch( Layer* layer, MovieTextLayerData* data, MovieTextEvent event )
 {
+  MovieTextAction action = transitions[data->state][event];
+
+  if( action )
+  {
+    action( layer, data );
+  }
 }
 
-static void _animation_stopped( struct Animation* animation, bool finished, void* context )
+static GRect _frame_at( Layer* layer, GPoint origin )
 {
-  Layer* layer = (Layer*)context;
-  with_movie_layer( layer, data,
+  return (GRect){
+    .origin = origin,
+    .size   = { .h = layer_get_frame( layer ).size.h, .w = SCREEN_WIDTH }
+  };
+}
+
+static bool _at_origin( Layer* layer, MovieTextLayerData* data )
+{
+  GRect frame = layer_get_frame( layer );
+  return frame.origin.x == data->origin.x && frame.origin.y == data->origin.y;
+}
+
+//
+// Effects
+//
+// A text change runs its effect twice: the old text goes (SlidingOut),
+// then the new one comes (SlidingIn). Slides and the wipe animate the
+// layer frame (the layer clips the text), dissolve and push are drawn by
+// _update_layer from data->progress. Moves always animate the frame.
+//
+// The cost is what the face weighs when it picks an effect: slides dirty
+// the old and the new frame, the wipe draws the full text every frame
+// (the narrower frame only clips it), the dissolve blits a dither mask
+// over the text, the push only redraws the text at an offset.
+//
+
+typedef void (*MovieTextEffectStep)( Layer* layer, MovieTextLayerData* data, uint32_t progress );
+
+typedef struct
+{
+  MovieTextEffectCost cost;
+  MovieTextEffectStep step;     // one animation frame, NULL: not animated
+} MovieTextEffect;
+
+static void _step_frame( Layer* layer, MovieTextLayerData* data, uint32_t progress );
+static void _step_wipe( Layer* layer, MovieTextLayerData* data, uint32_t progress );
+static void _step_draw( Layer* layer, MovieTextLayerData* data, uint32_t progress );
+
+#define EFFECT( duration, area, step ) { { duration, 2 * (duration) / FRAME_INTERVAL, area }, step }
+
+static const MovieTextEffect effects[] = {
+  [MovieTextUpdateNone]         = EFFECT( 0, 0, NULL ),
+  [MovieTextUpdateInstant]      = { { 0, 1, 8 }, NULL },
+  [MovieTextUpdateSlideLeft]    = EFFECT( SLIDE_DURATION,    16, _step_frame ),
+  [MovieTextUpdateSlideRight]   = EFFECT( SLIDE_DURATION,    16, _step_frame ),
+  [MovieTextUpdateSlideThrough] = EFFECT( SLIDE_DURATION,    16, _step_frame ),
+  [MovieTextUpdateWipe]         = EFFECT( WIPE_DURATION,      8, _step_wipe  ),
+  [MovieTextUpdateDissolve]     = EFFECT( DISSOLVE_DURATION, 16, _step_draw  ),
+  [MovieTextUpdatePush]         = EFFECT( PUSH_DURATION,      8, _step_draw  ),
+  [MovieTextUpdateDelay]        = EFFECT( 0, 0, NULL ),
+};
+
+// 4x4 Bayer dither, one 32x4 tile per level (bit set: pixel erased)
+#define DISSOLVE_LEVELS 16
+#define MASK_ROW( nibble ) ( (uint32_t)(nibble) * 0x11111111u )
+
+static const uint32_t dissolve_masks[DISSOLVE_LEVELS + 1][4] = {
+  { MASK_ROW( 0x0 ), MASK_ROW( 0x0 ), MASK_ROW( 0x0 ), MASK_ROW( 0x0 ) },  //  0/16
+  { MASK_ROW( 0x1 ), MASK_ROW( 0x0 ), MASK_ROW( 0x0 ), MASK_ROW( 0x0 ) },  //  1/16
+  { MASK_ROW( 0x1 ), MASK_ROW( 0x0 ), MASK_ROW( 0x4 ), MASK_ROW( 0x0 ) },  //  2/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0x0 ), MASK_ROW( 0x4 ), MASK_ROW( 0x0 ) },  //  3/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0x0 ), MASK_ROW( 0x5 ), MASK_ROW( 0x0 ) },  //  4/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0x2 ), MASK_ROW( 0x5 ), MASK_ROW( 0x0 ) },  //  5/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0x2 ), MASK_ROW( 0x5 ), MASK_ROW( 0x8 ) },  //  6/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0xa ), MASK_ROW( 0x5 ), MASK_ROW( 0x8 ) },  //  7/16
+  { MASK_ROW( 0x5 ), MASK_ROW( 0xa ), MASK_ROW( 0x5 ), MASK_ROW( 0xa ) },  //  8/16
+  { MASK_ROW( 0x7 ), MASK_ROW( 0xa ), MASK_ROW( 0x5 ), MASK_ROW( 0xa ) },  //  9/16
+  { MASK_ROW( 0x7 ), MASK_ROW( 0xa ), MASK_ROW( 0xd ), MASK_ROW( 0xa ) },  // 10/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xa ), MASK_ROW( 0xd ), MASK_ROW( 0xa ) },  // 11/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xa ), MASK_ROW( 0xf ), MASK_ROW( 0xa ) },  // 12/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xb ), MASK_ROW( 0xf ), MASK_ROW( 0xa ) },  // 13/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xb ), MASK_ROW( 0xf ), MASK_ROW( 0xe ) },  // 14/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xf ), MASK_ROW( 0xf ), MASK_ROW( 0xe ) },  // 15/16
+  { MASK_ROW( 0xf ), MASK_ROW( 0xf ), MASK_ROW( 0xf ), MASK_ROW( 0xf ) },  // 16/16
+};
+
+// addr is pointed at the level to draw, graphics_draw_bitmap_in_rect tiles it
+static GBitmap dissolve_mask = {
+  .addr = NULL,
+  .row_size_bytes = 4,
+  .info_flags = 0x1000,         // GBitmap version 1, not heap allocated
+  .bounds = { { 0, 0 }, { 32, 4 } }
+};
+
+static int16_t _lerp( int16_t from, int16_t to, uint32_t progress )
+{
+  return from + (int16_t)( ( (int32_t)( to - from ) * (int32_t)progress ) / ANIMATION_NORMALIZED_MAX );
+}
+
+static bool _is_slide( MovieTextLayerData* data )
+{
+  return effects[data->effect].step == _step_frame;
+}
+
+// slides, moves: data->from -> data->to
+static void _step_frame( Layer* layer, MovieTextLayerData* data, uint32_t progress )
+{
+  GRect frame = {
+    .origin = { _lerp( data->from.origin.x, data->to.origin.x, progress ),
+                _lerp( data->from.origin.y, data->to.origin.y, progress ) },
+    .size   = data->to.size
+  };
+  layer_set_frame( layer, frame );
+}
+
+// wipe: the frame stays at data->to, its width clips the text
+static void _step_wipe( Layer* layer, MovieTextLayerData* data, uint32_t progress )
+{
+  GRect frame = data->to;
+
+  frame.size.w = _lerp( 0, SCREEN_WIDTH, ( data->state == MovieTextStateSlidingOut )
+                                         ? ANIMATION_NORMALIZED_MAX - progress
+                                         : progress );
+  layer_set_frame( layer, frame );
+}
+
+// dissolve, push: _update_layer draws the phase
+static void _step_draw( Layer* layer, MovieTextLayerData* data, uint32_t progress )
+{
+  data->progress = progress;
+  layer_mark_dirty( layer );
+}
+
+// drawn effects: how far the current phase has taken the text away
+static uint32_t _gone( MovieTextLayerData* data )
+{
+  switch( data->state )
   {
-    GRect base = {
-      .origin = data->origin,
-      .size   = { .h = layer_get_frame( layer ).size.h, .w = SCREEN_WIDTH }
-    };
+    case MovieTextStateSlidingOut: return data->progress;
+    case MovieTextStateSlidingIn:  return ANIMATION_NORMALIZED_MAX - data->progress;
+    default:                       return 0;
+  }
+}
 
-    GRect off_screen = {
-      .origin = { .x = -SCREEN_WIDTH, .y = data->origin.y },
-      .size   = { .h = layer_get_frame( layer ).size.h, .w = SCREEN_WIDTH }
-    };
+static void _animate( MovieTextLayerData* data, GRect from, GRect to,
+                      uint32_t duration, MovieTextState state )
+{
+  if( data->state != MovieTextStateIdle )
+  {
+    // stopped( finished = false ) is ignored, see _animation_stopped
+    animation_unschedule( data->animation );
+  }
+
+  data->state = state;
+  data->from = from;
+  data->to = to;
+  data->progress = 0;
 
-    switch( data->animation_mode )
+  animation_set_delay( data->animation, data->delay ? START_DELAY : 0 );
+  animation_set_duration( data->animation, duration );
+  animation_schedule( data->animation );
+
+  data->delay = false;
+  if( activity.animations < UINT16_MAX )
+  {
+    ++activity.animations;
+  }
+}
+
+// pending becomes the drawn text, the measured size no longer fits
+static void _take_pending( MovieTextLayerData* data )
+{
+  strncpy( data->text, data->pending, sizeof( data->text ) );
+  data->text_size = GSizeZero;
+}
+
+// Idle / Moving + new text: move the old text off screen
+static void _slide_out( Layer* layer, MovieTextLayerData* data )
+{
+  GRect from = layer_get_frame( layer );
+  GRect to = from;
+
+  if( strcmp( data->text, data->pending ) == 0 )
+  {
+    // nothing visible changes, only the origin might
+    if( data->state == MovieTextStateIdle )
     {
-      case MovieTextUpdateNone:
-      case MovieTextUpdateInstant:
-      case MovieTextUpdateDelay:
-      break;
+      _move( layer, data );
+    }
+    return;
+  }
 
-      case MovieTextUpdateSlideRight:
-      case MovieTextUpdateSlideThrough:
-        off_screen.origin.x = SCREEN_WIDTH;
-        /* break; */
+  if( data->text[0] == '\0' )
+  {
+    // nothing to slide out
+    _slide_in( layer, data );
+    return;
+  }
 
-      case MovieTextUpdateSlideLeft:
+  if( _is_slide( data ) )
+  {
+    to.origin.x += ( data->effect == MovieTextUpdateSlideRight ) ? SCREEN_WIDTH
+                                                                 : -SCREEN_WIDTH;
+  }
+  _animate( data, from, to, effects[data->effect].cost.duration, MovieTextStateSlidingOut );
+}
+
+// SlidingOut done: bring in the pending text at the target origin
+static void _slide_in( Layer* layer, MovieTextLayerData* data )
+{
+  GRect base = _frame_at( layer, data->origin );
+  GRect start = base;
+
+  _take_pending( data );
+
+  if( data->text[0] == '\0' )
+  {
+    // nothing to slide in
+    _finish( layer, data );
+    return;
+  }
+
+  if( _is_slide( data ) )
+  {
+    start.origin.x += ( data->effect == MovieTextUpdateSlideLeft ) ? -SCREEN_WIDTH
+                                                                   : SCREEN_WIDTH;
+  }
+  else if( data->effect == MovieTextUpdateWipe )
+  {
+    start.size.w = 0;
+  }
+  layer_set_frame( layer, start );
+  _animate( data, start, base, effects[data->effect].cost.duration, MovieTextStateSlidingIn );
+}
+
+// Idle + new origin: move the current text
+static void _move( Layer* layer, MovieTextLayerData* data )
+{
+  if( _at_origin( layer, data ) )
+  {
+    _finish( layer, data );
+    return;
+  }
+  _animate( data, layer_get_frame( layer ), _frame_at( layer, data->origin ),
+            MOVE_DURATION, MovieTextStateMoving );
+}
+
+// SlidingIn + new text: nobody has read the entering text yet, replace it
+static void _swap_text( Layer* layer, MovieTextLayerData* data )
+{
+  _take_pending( data );
+  layer_mark_dirty( layer );
+}
+
+// SlidingIn / Moving + new origin: redirect the running animation
+static void _retarget( Layer* layer, MovieTextLayerData* data )
+{
+  data->to = _frame_at( layer, data->origin );
+
+  if( data->state == MovieTextStateSlidingIn && effects[data->effect].step == _step_draw )
+  {
+    // drawn in place, nothing moves the frame
+    layer_set_frame( layer, data->to );
+  }
+}
+
+static void _finish( Layer* layer, MovieTextLayerData* data )
+{
+  if( data->state != MovieTextStateIdle )
+  {
+    data->state = MovieTextStateIdle;
+    animation_unschedule( data->animation );
+  }
+
+  layer_set_frame( layer, _frame_at( layer, data->origin ) );
+  layer_mark_dirty( layer );
+}
+
+static uint32_t _now_ms( void )
+{
+  time_t sec;
+  uint16_t ms;
+
+  time_ms( &sec, &ms );
+  return (uint32_t)sec * 1000 + ms;
+}
+
+static void _animation_started( struct Animation* animation, void* context )
+{
+  with_movie_layer( (Layer*)context, data,
+  {
+    if( !data->running )
+    {
+      data->running = true;
+      if( running_layers++ == 0 )
       {
-        if( data->animating_out )
-        {
-          if( data->buf_r )
-          {
-            strncpy( data->buf_l, data->buf_r, sizeof( data->buf_l ) );
-          }
-        }
-        break;
+        running_since = _now_ms();
       }
-
     }
+  } )
+}
 
-    if( data->animating_out && finished )
+static void _animation_update( struct Animation* animation, const uint32_t progress )
+{
+  Layer* layer = (Layer*)animation_get_context( animation );
+  with_movie_layer( layer, data,
+  {
+    if( data->state == MovieTextStateMoving )
+    {
+      _step_frame( layer, data, progress );
+    }
+    else if( data->state != MovieTextStateIdle )
     {
+      effects[data->effect].step( layer, data, progress );
+    }
+  } )
+}
 
-      data->animating_out = false;
-      data->animating_in  = true;
+static const AnimationImplementation animation_implementation = {
+  .update = _animation_update
+};
 
-      data->animation->values.from.grect = off_screen;
-      data->animation->values.to.grect   = base;
+static void _animation_stopped( struct Animation* animation, bool finished, void* context )
+{
+  Layer* layer = (Layer*)context;
+  with_movie_layer( layer, data,
+  {
+    if( data->running )
+    {
+      data->running = false;
+      if( --running_layers == 0 )
+      {
+        uint32_t frames = activity.frames + ( _now_ms() - running_since ) / FRAME_INTERVAL;
+        activity.frames = frames < UINT16_MAX ? frames : UINT16_MAX;
+      }
+    }
 
-      layer_set_frame( (Layer*)layer, off_screen );
-      animation_set_delay( (Animation*)data->animation, 0 );
-      animation_set_duration( (Animation*)data->animation, 500 );
-      animation_schedule( (Animation*)data->animation );
+    // unfinished animations were stopped by a transition that already
+    // took care of the new state
+    if( !finished && activity.interrupted < UINT16_MAX )
+    {
+      ++activity.interrupted;
     }
-    else
+
+    if( finished && data->state != MovieTextStateIdle )
     {
-      layer_set_frame( layer, base );
+      MovieTextAction action = transitions[data->state][MovieTextEventDone];
 
-      data->animating_in  = false;
-      data->animating_out = false;
-      data->animation_mode = MovieTextUpdateInstant;
+      // the animation is no longer scheduled
+      data->state = MovieTextStateIdle;
+      action( layer, data );
     }
   } )
+
+  STACK_CHECK( STACK_PROBE_ANIMATION )
 }
 
 static void _update_layer( Layer* layer, GContext* ctx )
 {
   with_movie_layer( layer, data,
   {
+    // full width, a wipe only clips the text
     GRect frame = {
       .origin = GPointZero,
-      .size   = layer_get_frame( (Layer*)layer ).size
+      .size   = { .w = SCREEN_WIDTH, .h = layer_get_frame( (Layer*)layer ).size.h }
     };
-
-    if( data->animating_out || data->animating_in )
-    {
-      frame.size.w = SCREEN_WIDTH;
-    }
+    uint32_t gone = _gone( data );
 
     graphics_context_set_fill_color( ctx, data->bg );
     graphics_context_set_text_color( ctx, data->fg );
     graphics_context_set_stroke_color( ctx, data->fg );
 
-    graphics_draw_text( ctx, data->buf_l, data->font, frame,
+    if( data->effect == MovieTextUpdatePush && gone )
+    {
+      // out: up and away, in: up from below
+      int16_t offset = _lerp( 0, frame.size.h, gone );
+      frame.origin.y = ( data->state == MovieTextStateSlidingOut ) ? -offset : offset;
+    }
+
+    graphics_draw_text( ctx, data->text, data->font, frame,
                         GTextOverflowModeTrailingEllipsis,
                         GTextAlignmentLeft,
                         NULL );
+
+    if( data->effect == MovieTextUpdateDissolve && gone )
+    {
+      // only over the text, rows overlap and the mask would eat into the
+      // neighbours (the background is clear); laid out once per text, not
+      // once per frame
+      if( data->text_size.w == 0 )
+      {
+        data->text_size = graphics_text_layout_get_content_size( data->text, data->font, frame,
+                                                                 GTextOverflowModeTrailingEllipsis,
+                                                                 GTextAlignmentLeft );
+      }
+
+      GRect text_box = { .origin = GPointZero, .size = data->text_size };
+
+      dissolve_mask.addr = (void*)dissolve_masks[( gone * DISSOLVE_LEVELS ) / ANIMATION_NORMALIZED_MAX];
+      graphics_context_set_compositing_mode( ctx, ( data->fg == GColorWhite ) ? GCompOpClear : GCompOpOr );
+      graphics_draw_bitmap_in_rect( ctx, &dissolve_mask, text_box );
+      graphics_context_set_compositing_mode( ctx, GCompOpAssign );
+    }
+
+    STACK_CHECK( STACK_PROBE_DRAW_TEXT )
   })
 }
 
@@ -161,21 +531,26 @@ MovieTextLayer* movie_text_layer_create( GPoint origin, int16_t height )
     data->bg = GColorWhite;
     data->font = fonts_get_system_font( FONT_KEY_GOTHIC_14_BOLD );
     data->origin = frame.origin;
-    data->animating_out = false;
-    data->animating_in  = false;
-    data->animation_mode = MovieTextUpdateNone;
-    data->animation = property_animation_create_layer_frame( layer, &frame, &frame );
-
-    animation_set_handlers( (Animation*)data->animation,
+    data->state = MovieTextStateIdle;
+    data->effect = MovieTextUpdateSlideThrough;
+    data->delay = false;
+    data->running = false;
+    data->from = data->to = frame;
+    data->progress = 0;
+    data->text_size = GSizeZero;
+    data->animation = animation_create();
+
+    animation_set_implementation( data->animation, &animation_implementation );
+    animation_set_handlers( data->animation,
                             (AnimationHandlers){ 
                               .started = _animation_started, 
                               .stopped = _animation_stopped
                             },
                             (void*)layer );
-    animation_set_curve( (Animation*)data->animation, AnimationCurveEaseInOut );
+    animation_set_curve( data->animation, AnimationCurveEaseInOut );
 
-    memset( data->buf_l, 0, sizeof( data->buf_l ) );
-    data->buf_r = NULL;
+    memset( data->text, 0, sizeof( data->text ) );
+    memset( data->pending, 0, sizeof( data->pending ) );
 
     layer_set_update_proc( layer, _update_layer );
   } )
@@ -187,7 +562,12 @@ void movie_text_layer_destroy( MovieTextLayer* layer )
 {
   with_movie_layer( layer, data,
   {
-    property_animation_destroy( data->animation );
+    if( data->state != MovieTextStateIdle )
+    {
+      data->state = MovieTextStateIdle;
+      animation_unschedule( data->animation );
+    }
+    animation_destroy( data->animation );
     layer_destroy( layer );
   } )
 }
@@ -212,80 +592,29 @@ void movie_text_layer_set_text( MovieTextLayer* layer, const char* text,
 {
   with_movie_layer( layer, data,
   {
-    GRect base = layer_get_frame( (Layer*)layer );
-    base.size.w = SCREEN_WIDTH;
-
-    GRect offset_left = {
-      .origin = { .x = base.origin.x - SCREEN_WIDTH, .y = base.origin.y },
-      .size   = { .h = base.size.h  , .w = base.size.w }
-    };
+    strncpy( data->pending, text ? text : "", sizeof( data->pending ) - 1 );
 
-    GRect offset_right = {
-      .origin = { .x = base.origin.x + SCREEN_WIDTH, .y = base.origin.y },
-      .size   = { .h = base.size.h  , .w = base.size.w }
-    };
-
-    if( data->animating_out || data->animating_in )
-    {
-      animation_unschedule( (Animation*)data->animation );
-    }
-
-    data->animation_mode = mode;
     switch( mode )
     {
       case MovieTextUpdateNone:
       case MovieTextUpdateDelay:
-        {
-          strncpy( data->buf_l, text, sizeof( data->buf_l ) );
-
-          layer_set_frame( (Layer*)layer, base );
-        }
-        break;
-
       case MovieTextUpdateInstant:
         {
-          strncpy( data->buf_l, text, sizeof( data->buf_l ) );
-
-          layer_set_frame( (Layer*)layer, base );
-          layer_mark_dirty( (Layer*)layer );
+          _take_pending( data );
+          _finish( layer, data );
         }
         break;
 
+      case MovieTextUpdateSlideLeft:
       case MovieTextUpdateSlideRight:
-        {
-          // buf_l links außerhalb des fensters platzieren, dann "einfliegen"
-          // buf_l => neuer text
-          // buf_r => alter text
-          data->buf_r = (char*)text;
-
-          // take changed origin into account
-          data->animating_out = true;
-          data->animation->values.from.grect = base;
-          data->animation->values.to.grect   = offset_right;
-
-          //layer_set_frame( (Layer*)layer, offset_left );
-          animation_set_delay( (Animation*)data->animation, delay ? 100 : 0 );
-          animation_set_duration( (Animation*)data->animation, 500 );
-          animation_schedule( (Animation*)data->animation );
-        }
-        break;
-
       case MovieTextUpdateSlideThrough:
-      case MovieTextUpdateSlideLeft:
+      case MovieTextUpdateWipe:
+      case MovieTextUpdateDissolve:
+      case MovieTextUpdatePush:
         {
-          // buf_r rechts außerhalb des fensters platzieren, dann "einfliegen"
-          // buf_l => alter text
-          // buf_r => neuer text
-          data->buf_r = (char*)text;
-
-          data->animating_out = true;
-          data->animation->values.from.grect = base;
-          data->animation->values.to.grect   = offset_left;
-
-          //layer_set_frame( (Layer*)layer, offset_right );
-          animation_set_delay( (Animation*)data->animation, delay ? 100 : 0 );
-          animation_set_duration( (Animation*)data->animation, 500 );
-          animation_schedule( (Animation*)data->animation );
+          data->effect = mode;
+          data->delay = delay;
+          _dispatch( layer, data, MovieTextEventText );
         }
         break;
     }
@@ -295,28 +624,23 @@ void movie_text_layer_set_text( MovieTextLayer* layer, const char* text,
 void movie_text_layer_set_origin( MovieTextLayer* layer, GPoint origin, 
                                   MovieTextUpdateMode mode, bool delay )
 {
-  //FIXME: this creates a permanent allocaton of 28B.. no Idea how or where..
   with_movie_layer( layer, data,
   {
-    GRect base = {
-      .origin = origin,
-      .size = { .h = layer_get_frame( (Layer*)layer ).size.h, .w = SCREEN_WIDTH }
-    };
-
-    if( ( data->animating_out || data->animating_in ) && mode != MovieTextUpdateDelay )
-    {
-      animation_unschedule( (Animation*)data->animation );
-    }
-
     data->origin = origin;
-    data->animation_mode = MovieTextUpdateNone;
 
     switch( mode )
     {
       case MovieTextUpdateNone:
       {
-        layer_set_frame( (Layer*)layer, base );
-        layer_mark_dirty( (Layer*)layer );
+        // jump, unless a text change is under way
+        if( data->state == MovieTextStateIdle || data->state == MovieTextStateMoving )
+        {
+          _finish( layer, data );
+        }
+        else
+        {
+          _dispatch( layer, data, MovieTextEventMove );
+        }
         break;
       }
 
@@ -324,28 +648,31 @@ void movie_text_layer_set_origin( MovieTextLayer* layer, GPoint origin,
       case MovieTextUpdateSlideLeft:
       case MovieTextUpdateSlideRight:
       case MovieTextUpdateSlideThrough:
+      case MovieTextUpdateWipe:
+      case MovieTextUpdateDissolve:
+      case MovieTextUpdatePush:
       {
-        data->animating_in = true;
-        data->animating_out = false;
-        data->animation->values.from.grect = layer_get_frame( (Layer*)layer );
-        data->animation->values.to.grect   = base;
-
-        animation_set_delay( (Animation*)data->animation, delay ? 100 : 0 );
-        animation_set_duration( (Animation*)data->animation, 1000 );
-        animation_schedule( (Animation*)data->animation );
+        data->delay = delay;
+        _dispatch( layer, data, MovieTextEventMove );
         break;
       }
 
       case MovieTextUpdateDelay:
-        data->origin = origin;
+      {
+        // picked up by the next text animation, or now if one is running
+        if( data->state != MovieTextStateIdle )
+        {
+          _dispatch( layer, data, MovieTextEventMove );
+        }
         break;
+      }
     }
   } );
 }
 
 void movie_text_layer_set_font( MovieTextLayer* layer, GFont font )
 {
-  with_movie_layer( layer, data, { data->font = font; } );
+  with_movie_layer( layer, data, { data->font = font; data->text_size = GSizeZero; } );
 }
 
 GColor movie_text_layer_get_text_color( MovieTextLayer* layer )
@@ -360,24 +687,12 @@ GColor movie_text_layer_get_background_color( MovieTextLayer* layer )
   return GColorClear;
 }
 
+// The text the layer shows once all running animations are done
 const char* movie_text_layer_get_text( MovieTextLayer* layer )
 {
   with_movie_layer( layer, data,
   {
-    if( data->animating_out || data->animating_in )
-    {
-      switch( data->animation_mode )
-      {
-        case MovieTextUpdateNone:
-        case MovieTextUpdateDelay:
-        case MovieTextUpdateInstant:
-        case MovieTextUpdateSlideLeft:
-        case MovieTextUpdateSlideRight:
-        case MovieTextUpdateSlideThrough:
-          return data->buf_r;
-      }
-    }
-    return data->buf_l;
+    return ( data->state == MovieTextStateSlidingOut ) ? data->pending : data->text;
   } )
   return "(null)";
 }
@@ -393,3 +708,55 @@ GFont movie_text_layer_get_font( MovieTextLayer* layer )
   with_movie_layer( layer, data, { return data->font; } );
   return fonts_get_system_font( FONT_KEY_GOTHIC_14_BOLD );
 }
+
+MovieTextState movie_text_layer_get_state( MovieTextLayer* layer )
+{
+  with_movie_layer( layer, data, { return data->state; } );
+  return MovieTextStateIdle;
+}
+
+void movie_text_layer_get_activity( MovieTextActivity* stats, bool reset )
+{
+  if( stats )
+  {
+    *stats = activity;
+  }
+  if( reset )
+  {
+    activity.animations = 0;
+    activity.frames = 0;
+    activity.interrupted = 0;
+  }
+}
+
+const MovieTextEffectCost* movie_text_layer_get_effect_cost( MovieTextUpdateMode mode )
+{
+  return &effects[mode].cost;
+}
+
+// pixels one text change touches in a layer of the given height
+uint32_t movie_text_layer_effect_pixels( MovieTextUpdateMode mode, int16_t height )
+{
+  const MovieTextEffectCost* cost = &effects[mode].cost;
+  return ( (uint32_t)cost->frames * cost->area * SCREEN_WIDTH * height ) / 8;
+}
+
+// cheapest of the given MOVIE_TEXT_EFFECT() set, instant if it is empty
+MovieTextUpdateMode movie_text_layer_cheapest_effect( uint16_t set )
+{
+  MovieTextUpdateMode best = MovieTextUpdateInstant;
+  MovieTextUpdateMode mode;
+  uint16_t best_cost = UINT16_MAX;
+
+  for( mode = MovieTextUpdateInstant; mode < MovieTextUpdateDelay; ++mode )
+  {
+    uint16_t cost = (uint16_t)effects[mode].cost.frames * effects[mode].cost.area;
+
+    if( ( set & MOVIE_TEXT_EFFECT( mode ) ) && cost < best_cost )
+    {
+      best = mode;
+      best_cost = cost;
+    }
+  }
+  return best;
+}
@@ -40,9 +40,42 @@ typedef enum
   MovieTextUpdateSlideLeft,     // slide-to-left animation
   MovieTextUpdateSlideRight,    // slide-to-right animation
   MovieTextUpdateSlideThrough,  // slide-left-out-right-in animation
+  MovieTextUpdateWipe,          // wipe out to the left, wipe in to the right
+  MovieTextUpdateDissolve,      // dither out, dither in
+  MovieTextUpdatePush,          // short push up: old text out, new text in from below
   MovieTextUpdateDelay          // Delay update until next animation (only origin)
 } MovieTextUpdateMode;
 
+// Set of update modes for movie_text_layer_cheapest_effect()
+#define MOVIE_TEXT_EFFECT( mode ) ( 1 << (mode) )
+
+// What one text change (out + in) costs with a given update mode
+typedef struct
+{
+  uint16_t duration;  // ms per phase
+  uint8_t  frames;    // frames drawn for both phases
+  uint8_t  area;      // pixels touched per frame, in 1/8 of the layer area
+} MovieTextEffectCost;
+
+// Animation state of a layer, see the transition table in movie_text_layer.c
+typedef enum
+{
+  MovieTextStateIdle,        // text shown at its origin
+  MovieTextStateSlidingOut,  // old text leaving, new text pending
+  MovieTextStateSlidingIn,   // new text entering towards the origin
+  MovieTextStateMoving,      // same text moving to a new origin
+  MovieTextStateCount
+} MovieTextState;
+
+// Animations started and animation frames, always counted (battery
+// telemetry); counted when animations start and stop, not per frame
+typedef struct
+{
+  uint16_t animations;
+  uint16_t frames;       // screen frames with at least one layer animating
+  uint16_t interrupted;  // animations cut short by a newer request
+} MovieTextActivity;
+
 MovieTextLayer* movie_text_layer_create( GPoint origin, int16_t hight );
 void movie_text_layer_destroy( MovieTextLayer* layer );
 Layer* movie_text_layer_get_layer( MovieTextLayer* layer );
@@ -58,5 +91,12 @@ GColor movie_text_layer_get_background_color( MovieTextLayer* layer );
 const char* movie_text_layer_get_text( MovieTextLayer* layer );
 GPoint movie_textLayer_get_origin( MovieTextLayer* layer );
 GFont movie_text_layer_get_font( MovieTextLayer* layer );
+MovieTextState movie_text_layer_get_state( MovieTextLayer* layer );
+
+void movie_text_layer_get_activity( MovieTextActivity* stats, bool reset );
+
+const MovieTextEffectCost* movie_text_layer_get_effect_cost( MovieTextUpdateMode mode );
+uint32_t movie_text_layer_effect_pixels( MovieTextUpdateMode mode, int16_t height );
+MovieTextUpdateMode movie_text_layer_cheapest_effect( uint16_t effects );
 
 #endif
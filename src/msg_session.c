@@ -0,0 +1,175 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /msg_session.c, created 2026-10-19 / */
+
+#include "msg_session.h"
+#include "telemetry.h"
+#include "trace.h"
+
+static AppMessageInboxReceived inbox_received = NULL;
+static AppTimer *idle_timer = 0;
+
+static void _on_idle( void *data __attribute__((__unused__)) )
+{
+  idle_timer = 0;
+  app_comm_set_sniff_interval( SNIFF_INTERVAL_NORMAL );
+}
+
+// keep the radio responsive while messages are flowing
+static void _touch( void )
+{
+  if( idle_timer == 0 )
+  {
+    app_comm_set_sniff_interval( SNIFF_INTERVAL_REDUCED );
+    idle_timer = app_timer_register( MSG_IDLE_MS, _on_idle, NULL );
+  }
+  else
+  {
+    app_timer_reschedule( idle_timer, MSG_IDLE_MS );
+  }
+}
+
+static void _on_received( DictionaryIterator *it, void *ctx )
+{
+  _touch();
+  if( inbox_received )
+  {
+    inbox_received( it, ctx );
+  }
+}
+
+static void _on_dropped( AppMessageResult reason, void *ctx __attribute__((__unused__)) )
+{
+  TRACE_ARGS( TRACE_APP_MESSAGE_ERROR, 0, reason )
+
+  APP_LOG( APP_LOG_LEVEL_ERROR, "Inbox dropped: %d", reason );
+}
+
+static void _on_sent( DictionaryIterator *it __attribute__((__unused__)),
+                      void *ctx __attribute__((__unused__)) )
+{
+  _touch();
+}
+
+static void _on_failed( DictionaryIterator *it __attribute__((__unused__)),
+                        AppMessageResult reason, void *ctx __attribute__((__unused__)) )
+{
+  TRACE_ARGS( TRACE_APP_MESSAGE_ERROR, 1, reason )
+
+  APP_LOG( APP_LOG_LEVEL_ERROR, "Outbox failed: %d", reason );
+}
+
+void msg_session_init( AppMessageInboxReceived received )
+{
+  inbox_received = received;
+
+  app_message_register_inbox_received( _on_received );
+  app_message_register_inbox_dropped( _on_dropped );
+  app_message_register_outbox_sent( _on_sent );
+  app_message_register_outbox_failed( _on_failed );
+
+  app_message_open( MSG_INBOX_SIZE, MSG_OUTBOX_SIZE );
+}
+
+void msg_session_deinit( void )
+{
+  app_message_deregister_callbacks();
+  inbox_received = NULL;
+
+  if( idle_timer )
+  {
+    app_timer_cancel( idle_timer );
+    idle_timer = 0;
+    app_comm_set_sniff_interval( SNIFF_INTERVAL_NORMAL );
+  }
+}
+
+DictionaryIterator* msg_session_begin( void )
+{
+  DictionaryIterator *it = NULL;
+
+  if( app_message_outbox_begin( &it ) != APP_MSG_OK )
+  {
+    return NULL;
+  }
+  return it;
+}
+
+bool msg_session_send( void )
+{
+  if( app_message_outbox_send() != APP_MSG_OK )
+  {
+    return false;
+  }
+
+  _touch();
+  telemetry_count( TELEMETRY_APP_MESSAGE );
+  return true;
+}
+
+static void _retry_after( MsgRetry* retry, uint32_t delay_ms, AppTimerCallback callback )
+{
+  if( retry->timer == 0 )
+  {
+    retry->timer = app_timer_register( delay_ms, callback, NULL );
+  }
+  else
+  {
+    app_timer_reschedule( retry->timer, delay_ms );
+  }
+}
+
+bool msg_retry_failed( MsgRetry* retry, AppTimerCallback callback )
+{
+  uint32_t delay_ms = MSG_RETRY_FIRST_MS << retry->failures;
+
+  if( retry->failures >= MSG_RETRY_LIMIT )
+  {
+    msg_retry_cancel( retry );
+    return false;
+  }
+
+  ++retry->failures;
+  _retry_after( retry, delay_ms < MSG_RETRY_MAX_MS ? delay_ms : MSG_RETRY_MAX_MS, callback );
+  return true;
+}
+
+void msg_retry_next( MsgRetry* retry, AppTimerCallback callback )
+{
+  retry->failures = 0;
+  _retry_after( retry, MSG_RETRY_FIRST_MS, callback );
+}
+
+void msg_retry_cancel( MsgRetry* retry )
+{
+  if( retry->timer )
+  {
+    app_timer_cancel( retry->timer );
+    retry->timer = 0;
+  }
+  retry->failures = 0;
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /msg_session.h, created 2026-10-19 / */
+
+#ifndef __MSG_SESSION_H
+#define __MSG_SESSION_H
+
+#include <pebble.h>
+#include "settings_record.h"
+
+// AppMessage with the smallest buffers the face needs.
+//
+// SDK 2 can't close AppMessage again, so the buffers are sized for the
+// largest message instead: one tuple from the phone, the settings record
+// or a 32 bit trigger (inbox), and one trace / telemetry chunk (outbox).
+// While messages are flowing the radio is switched to the reduced sniff
+// interval, after MSG_IDLE_MS without traffic it goes back to the normal
+// one.
+
+// dictionary header + per tuple header (key, type, length) + data
+#define MSG_DICT_SIZE( tuples, data ) ( 1 + 7 * ( tuples ) + ( data ) )
+
+#define MSG_INBOX_DATA  ( SETTINGS_RECORD_SIZE > 4 ? SETTINGS_RECORD_SIZE : 4 )
+#define MSG_INBOX_SIZE  MSG_DICT_SIZE( 1, MSG_INBOX_DATA )
+#define MSG_OUTBOX_SIZE 64
+#define MSG_IDLE_MS     5000
+
+// Retry timer for senders that found the outbox busy: the delay doubles
+// from MSG_RETRY_FIRST_MS up to MSG_RETRY_MAX_MS, after MSG_RETRY_LIMIT
+// failures in a row the sender gives up until it is asked again. The
+// callback has to clear retry->timer.
+#define MSG_RETRY_FIRST_MS 250
+#define MSG_RETRY_MAX_MS   8000
+#define MSG_RETRY_LIMIT    6
+
+typedef struct
+{
+  AppTimer *timer;
+  uint8_t   failures;
+} MsgRetry;
+
+void msg_session_init( AppMessageInboxReceived received );
+void msg_session_deinit( void );
+
+// Outbox access, NULL while the outbox is busy
+DictionaryIterator* msg_session_begin( void );
+bool msg_session_send( void );
+
+bool msg_retry_failed( MsgRetry* retry, AppTimerCallback callback );  // false: given up
+void msg_retry_next( MsgRetry* retry, AppTimerCallback callback );    // sent, go on with the next chunk
+void msg_retry_cancel( MsgRetry* retry );
+
+#endif
@@ -0,0 +1,80 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* /settings_record.c, created 2026-10-19 / */
+
+#include "settings_record.h"
+
+#define SETTINGS_FIELD_BITS_ENTRY( id, name, bits, def ) bits,
+
+static const uint8_t field_bits[SETTING_COUNT] = {
+  SETTINGS_SCHEMA( SETTINGS_FIELD_BITS_ENTRY )
+};
+
+void settings_record_pack( const SettingsRecord *record, uint8_t *data )
+{
+  uint16_t bit = 0;
+  uint8_t f, b;
+
+  memset( data, 0, SETTINGS_RECORD_SIZE );
+  data[0] = SETTINGS_VERSION;
+
+  for( f = 0; f < SETTING_COUNT; ++f )
+  {
+    for( b = 0; b < field_bits[f]; ++b, ++bit )
+    {
+      if( record->value[f] & ( 1 << b ) )
+      {
+        data[1 + bit / 8] |= ( 1 << ( bit % 8 ) );
+      }
+    }
+  }
+}
+
+bool settings_record_unpack( SettingsRecord *record, const uint8_t *data, uint16_t length )
+{
+  uint16_t bit = 0;
+  uint8_t f, b;
+
+  if( length < SETTINGS_RECORD_SIZE || data[0] != SETTINGS_VERSION )
+  {
+    return false;
+  }
+
+  for( f = 0; f < SETTING_COUNT; ++f )
+  {
+    record->value[f] = 0;
+    for( b = 0; b < field_bits[f]; ++b, ++bit )
+    {
+      if( data[1 + bit / 8] & ( 1 << ( bit % 8 ) ) )
+      {
+        record->value[f] |= ( 1 << b );
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* /settings_record.h, created 2026-10-19 / */
+
+#ifndef __SETTINGS_RECORD_H
+#define __SETTINGS_RECORD_H
+
+#include <pebble.h>
+#include "settings_schema.h"
+
+// Bit-packed, versioned settings as one byte-array tuple.
+//
+// byte 0 is SETTINGS_VERSION, the fields of SETTINGS_SCHEMA follow
+// LSB first. A record with another version is rejected as a whole.
+
+#define SETTINGS_FIELD_ID( id, name, bits, def ) SETTING_##id,
+#define SETTINGS_FIELD_BITS( id, name, bits, def ) + (bits)
+#define SETTINGS_FIELD_DEFAULT( id, name, bits, def ) SETTING_DEFAULT_##id = (def),
+
+typedef enum
+{
+  SETTINGS_SCHEMA( SETTINGS_FIELD_ID )
+  SETTING_COUNT
+} SettingsField;
+
+enum
+{
+  SETTINGS_SCHEMA( SETTINGS_FIELD_DEFAULT )
+};
+
+#define SETTINGS_RECORD_BITS ( 0 SETTINGS_SCHEMA( SETTINGS_FIELD_BITS ) )
+#define SETTINGS_RECORD_SIZE ( 1 + ( SETTINGS_RECORD_BITS + 7 ) / 8 )
+
+typedef struct
+{
+  uint8_t value[SETTING_COUNT];
+} SettingsRecord;
+
+void settings_record_pack( const SettingsRecord *record, uint8_t *data );
+bool settings_record_unpack( SettingsRecord *record, const uint8_t *data, uint16_t length );
+
+#endif
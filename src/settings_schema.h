@@ -0,0 +1,50 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* /settings_schema.h, created 2026-10-19 / */
+
+#ifndef __SETTINGS_SCHEMA_H
+#define __SETTINGS_SCHEMA_H
+
+// The settings record, shared by the watch (settings_record.c) and the
+// phone (tools/settings_schema.py puts it into pebble-js-app.js).
+//
+//   SETTING( id, "config page / localStorage name", bits, default )
+//
+// Fields are packed LSB first in this order behind the version byte.
+// Append new fields at the end; changing or removing one needs a new
+// SETTINGS_VERSION.
+
+#define SETTINGS_VERSION 1
+
+#define SETTINGS_SCHEMA( SETTING ) \
+  SETTING( INVERTER_STATE,  "settings_inverter_state",  1, 0 ) \
+  SETTING( STATUS_VISIBLE,  "settings_status_visible",  1, 0 ) \
+  SETTING( ACCEL_CONFIG,    "settings_accel_config",    1, 1 ) \
+  SETTING( REGULAR_FONTSET, "settings_regular_fontset", 1, 0 )
+
+#endif
@@ -0,0 +1,104 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /stack_probe.c, created 2026-10-19 / */
+
+#include "stack_probe.h"
+#include "trace.h"
+
+#if STACK_PROBE
+
+// room for the painting function's own frame
+#define PAINT_GUARD 64
+
+static uint8_t *stack_top = NULL;
+static uint16_t high_water[STACK_PROBE_SITE_COUNT];
+
+static const char* SITE_NAMES[STACK_PROBE_SITE_COUNT] = {
+  "tick", "invalidate", "draw status", "draw text", "animation",
+  "message", "battery", "bluetooth", "tap"
+};
+
+// paints from just below the caller down to the end of the probed area;
+// a plain loop, memset() would need stack inside the painted area
+static void __attribute__((noinline)) _paint( void )
+{
+  volatile uint8_t here = 0;
+  uint8_t *p   = (uint8_t*)&here - PAINT_GUARD;
+  uint8_t *end = stack_top - STACK_PROBE_DEPTH;
+
+  while( p > end )
+  {
+    *--p = STACK_PROBE_PATTERN;
+  }
+}
+
+void stack_probe_init( void )
+{
+  volatile uint8_t here = 0;
+
+  stack_top = (uint8_t*)&here;
+  memset( high_water, 0, sizeof( high_water ) );
+  _paint();
+}
+
+void stack_probe_check( StackProbeSite site )
+{
+  uint8_t *p = stack_top - STACK_PROBE_DEPTH;
+  uint16_t used;
+
+  if( stack_top == NULL )
+  {
+    return;
+  }
+
+  while( p < stack_top && *p == STACK_PROBE_PATTERN )
+  {
+    ++p;
+  }
+  used = (uint16_t)( stack_top - p );
+
+  if( used > high_water[site] )
+  {
+    high_water[site] = used;
+    TRACE_ARGS( TRACE_STACK_HIGH_WATER, site, used )
+  }
+
+  _paint();
+}
+
+void stack_probe_log( void )
+{
+  int i;
+
+  for( i = 0; i < STACK_PROBE_SITE_COUNT; ++i )
+  {
+    APP_LOG( APP_LOG_LEVEL_INFO, "stack[%s]: %u of %u bytes",
+             SITE_NAMES[i], high_water[i], STACK_PROBE_DEPTH );
+  }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /stack_probe.h, created 2026-10-19 / */
+
+#ifndef __STACK_PROBE_H
+#define __STACK_PROBE_H
+
+#include <pebble.h>
+
+// Stack high-water marks per event handler (debug builds).
+//
+// stack_probe_init() remembers the stack position in main() and paints
+// STACK_PROBE_DEPTH bytes below it with a pattern. STACK_CHECK() at the
+// end of a handler finds the deepest overwritten byte, keeps the worst
+// case for that handler and paints the area again for the next one.
+//
+// stack_probe.c is only linked with ./waf configure --debug-harness,
+// which also switches the probe on.
+
+#ifndef DEBUG_HARNESS
+#define DEBUG_HARNESS 0
+#endif
+
+#define STACK_PROBE DEBUG_HARNESS
+
+#define STACK_PROBE_DEPTH   1536  // must stay below the app stack size
+#define STACK_PROBE_PATTERN 0xA5
+
+typedef enum
+{
+  STACK_PROBE_TICK,         // on_minute_tick / test date tick
+  STACK_PROBE_INVALIDATE,   // on_invalidate (copy_time, update_rows)
+  STACK_PROBE_DRAW_STATUS,  // update_status
+  STACK_PROBE_DRAW_TEXT,    // movie text layer update proc
+  STACK_PROBE_ANIMATION,    // movie text animation stopped
+  STACK_PROBE_MESSAGE,      // AppMessage inbox
+  STACK_PROBE_BATTERY,
+  STACK_PROBE_BLUETOOTH,
+  STACK_PROBE_TAP,
+  STACK_PROBE_SITE_COUNT
+} StackProbeSite;
+
+#if STACK_PROBE
+# define STACK_CHECK( site )  stack_probe_check( (site) );
+
+void stack_probe_init( void );
+void stack_probe_check( StackProbeSite site );
+void stack_probe_log( void );
+#else
+# define STACK_CHECK( site )
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /str_builder.c, created 2026-10-19 / */
+
+#include "str_builder.h"
+
+#define is_utf8_continuation( c ) ( ( (uint8_t)(c) & 0xC0 ) == 0x80 )
+
+void str_builder_init( StrBuilder* sb, char* buf, uint8_t size )
+{
+  sb->buf = buf;
+  sb->size = size;
+  sb->len = 0;
+  sb->truncated = ( size == 0 );
+
+  if( size > 0 )
+  {
+    buf[0] = '\0';
+  }
+}
+
+bool str_builder_append( StrBuilder* sb, const char* str )
+{
+  const char* start = str;
+
+  if( sb->truncated )
+  {
+    return false;
+  }
+
+  while( *str )
+  {
+    if( sb->len + 1 >= sb->size )
+    {
+      // never leave half a UTF-8 sequence behind, but only take back what
+      // this call appended (str must not run in front of its start)
+      while( str > start && is_utf8_continuation( *str ) )
+      {
+        --str;
+        --sb->len;
+      }
+      sb->buf[sb->len] = '\0';
+      sb->truncated = true;
+      return false;
+    }
+    sb->buf[sb->len++] = *str++;
+  }
+
+  sb->buf[sb->len] = '\0';
+  return true;
+}
+
+bool str_builder_append_char( StrBuilder* sb, char c )
+{
+  char str[2] = { c, '\0' };
+  return str_builder_append( sb, str );
+}
+
+bool str_builder_append_uint( StrBuilder* sb, uint16_t value )
+{
+  char digits[6];
+  int  pos = sizeof( digits ) - 1;
+
+  digits[pos] = '\0';
+  do
+  {
+    digits[--pos] = '0' + ( value % 10 );
+    value /= 10;
+  }
+  while( value > 0 );
+
+  return str_builder_append( sb, &digits[pos] );
+}
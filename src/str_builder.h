@@ -0,0 +1,53 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /str_builder.h, created 2026-10-19 / */
+
+#ifndef __STR_BUILDER_H
+#define __STR_BUILDER_H
+
+#include <pebble.h>
+
+// Fixed-capacity string builder for row and status texts.
+//
+// The buffer is always '\0' terminated. An append that does not fit copies
+// as much as possible without splitting a UTF-8 sequence of the appended
+// string, marks the builder as truncated and returns false; all following
+// appends are dropped.
+typedef struct
+{
+  char    *buf;
+  uint8_t  size;       // capacity including the terminating '\0'
+  uint8_t  len;
+  bool     truncated;
+} StrBuilder;
+
+void str_builder_init( StrBuilder* sb, char* buf, uint8_t size );
+bool str_builder_append( StrBuilder* sb, const char* str );
+bool str_builder_append_char( StrBuilder* sb, char c );
+bool str_builder_append_uint( StrBuilder* sb, uint16_t value );
+
+#endif
@@ -0,0 +1,264 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /telemetry.c, created 2026-10-19 / */
+
+#include "telemetry.h"
+#include "movie_text_layer.h"
+#include "msg_session.h"
+
+typedef struct
+{
+  uint8_t head;
+  uint8_t count;
+  uint8_t reserved[2];
+  TelemetrySample samples[TELEMETRY_SAMPLES];
+} __attribute__((__packed__)) TelemetryRing;
+
+// The hour being counted. The face is unloaded whenever the menu or an
+// app is opened, so deinit stores it and the next init carries on with it.
+typedef struct
+{
+  uint32_t start;         // full hour, unix time
+  uint16_t animations;    // counted before the last restart
+  uint16_t frames;
+  uint8_t  counters[TELEMETRY_COUNTER_COUNT];
+  uint8_t  charge;        // percent at the last deinit
+  uint8_t  flags;
+} __attribute__((__packed__)) TelemetryHour;
+
+static TelemetryRing ring;
+static TelemetryHour hour;
+static uint8_t charge_percent = 0;
+
+static uint32_t storage_key = 0;
+static uint32_t hour_key = 0;
+
+static uint32_t send_since = 0;
+static MsgRetry send_retry;
+
+static void _send_next( void );
+
+static void _on_send_timer( void *data __attribute__((__unused__)) )
+{
+  send_retry.timer = 0;
+  _send_next();
+}
+
+static TelemetrySample* _sample_at( uint8_t i )
+{
+  return &ring.samples[( ring.head + i ) % TELEMETRY_SAMPLES];
+}
+
+static uint32_t _hour_start( uint32_t t )
+{
+  return t - t % 3600;
+}
+
+static uint16_t _add16( uint16_t a, uint16_t b )
+{
+  return ( a > UINT16_MAX - b ) ? UINT16_MAX : a + b;
+}
+
+static uint8_t _add8( uint8_t a, uint8_t b )
+{
+  return ( a > UINT8_MAX - b ) ? UINT8_MAX : a + b;
+}
+
+// moves what the face counted since the last call into the hour
+static void _collect( void )
+{
+  MovieTextActivity activity;
+
+  movie_text_layer_get_activity( &activity, true );
+  hour.animations = _add16( hour.animations, activity.animations );
+  hour.frames     = _add16( hour.frames, activity.frames );
+}
+
+static void _push_sample( uint32_t time, uint8_t charge )
+{
+  TelemetrySample *sample;
+
+  if( ring.count == TELEMETRY_SAMPLES )
+  {
+    ring.head = ( ring.head + 1 ) % TELEMETRY_SAMPLES;
+    --ring.count;
+  }
+  sample = _sample_at( ring.count++ );
+
+  sample->time         = time;
+  sample->animations   = hour.animations;
+  sample->frames       = hour.frames;
+  sample->charge       = charge;
+  sample->flags        = hour.flags;
+  sample->app_messages = hour.counters[TELEMETRY_APP_MESSAGE];
+  sample->bt_flaps     = hour.counters[TELEMETRY_BT_FLAP];
+}
+
+static void _start_hour( uint32_t start, uint8_t flags )
+{
+  memset( &hour, 0, sizeof( hour ) );
+  hour.start = start;
+  hour.flags = flags;
+}
+
+void telemetry_init( uint32_t key, uint32_t running_key )
+{
+  uint32_t now = (uint32_t)time( NULL );
+
+  storage_key = key;
+  hour_key = running_key;
+  memset( &ring, 0, sizeof( ring ) );
+
+  if( persist_exists( storage_key ) &&
+      persist_get_size( storage_key ) == (int)sizeof( ring ) )
+  {
+    persist_read_data( storage_key, &ring, sizeof( ring ) );
+  }
+  if( ring.head >= TELEMETRY_SAMPLES || ring.count > TELEMETRY_SAMPLES )
+  {
+    memset( &ring, 0, sizeof( ring ) );
+  }
+
+  memset( &hour, 0, sizeof( hour ) );
+  if( persist_exists( hour_key ) &&
+      persist_get_size( hour_key ) == (int)sizeof( hour ) )
+  {
+    persist_read_data( hour_key, &hour, sizeof( hour ) );
+  }
+
+  if( hour.start != _hour_start( now ) )
+  {
+    if( hour.start != 0 && hour.start < _hour_start( now ) )
+    {
+      // the face was not running at the end of that hour, its sample is
+      // stored late and without the charge at the full hour
+      hour.flags |= TELEMETRY_PARTIAL;
+      _push_sample( hour.start + 3600, hour.charge );
+      persist_write_data( storage_key, &ring, sizeof( ring ) );
+    }
+
+    // the start of this hour was missed
+    _start_hour( _hour_start( now ), TELEMETRY_PARTIAL );
+  }
+
+  telemetry_battery( battery_state_service_peek() );
+}
+
+void telemetry_deinit( void )
+{
+  // the hour goes on with the next init
+  _collect();
+  hour.charge = charge_percent;
+  persist_write_data( hour_key, &hour, sizeof( hour ) );
+
+  msg_retry_cancel( &send_retry );
+}
+
+void telemetry_count( TelemetryCounter counter )
+{
+  hour.counters[counter] = _add8( hour.counters[counter], 1 );
+}
+
+void telemetry_battery( BatteryChargeState charge )
+{
+  charge_percent = charge.charge_percent;
+  if( charge.is_charging || charge.is_plugged )
+  {
+    hour.flags |= TELEMETRY_CHARGING;
+  }
+}
+
+void telemetry_sample( uint32_t now )
+{
+  _collect();
+  _push_sample( now, charge_percent );
+  persist_write_data( storage_key, &ring, sizeof( ring ) );
+
+  // the charger flag sticks for the next hour if it is still connected
+  _start_hour( _hour_start( now ), 0 );
+  telemetry_battery( battery_state_service_peek() );
+}
+
+// Sends all samples newer than 'since' (the newest time the phone has),
+// one chunk per call: format, sample count, then TelemetrySamples.
+void telemetry_send( uint32_t since )
+{
+  send_since = since;
+  msg_retry_cancel( &send_retry );
+  _send_next();
+}
+
+static void _send_next( void )
+{
+  uint8_t chunk[2 + TELEMETRY_CHUNK * sizeof( TelemetrySample )];
+  uint8_t i, count = 0;
+  uint32_t last = send_since;
+  DictionaryIterator *it;
+
+  for( i = 0; i < ring.count && count < TELEMETRY_CHUNK; ++i )
+  {
+    TelemetrySample *sample = _sample_at( i );
+    if( sample->time > send_since )
+    {
+      memcpy( &chunk[2 + count * sizeof( TelemetrySample )], sample, sizeof( TelemetrySample ) );
+      last = sample->time;
+      ++count;
+    }
+  }
+
+  if( count == 0 )
+  {
+    return;
+  }
+
+  if( ( it = msg_session_begin() ) == NULL )
+  {
+    // outbox busy, try again later
+    msg_retry_failed( &send_retry, _on_send_timer );
+    return;
+  }
+
+  chunk[0] = TELEMETRY_FORMAT;
+  chunk[1] = count;
+
+  dict_write_data( it, storage_key, chunk, 2 + count * sizeof( TelemetrySample ) );
+  dict_write_end( it );
+
+  if( !msg_session_send() )
+  {
+    msg_retry_failed( &send_retry, _on_send_timer );
+    return;
+  }
+
+  send_since = last;
+
+  // samples are in time order, the rest of the ring is newer
+  if( i < ring.count )
+  {
+    msg_retry_next( &send_retry, _on_send_timer );
+  }
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /telemetry.h, created 2026-10-19 / */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include <pebble.h>
+
+// Hourly battery telemetry.
+//
+// Each hour the charge level is stored together with what the face did in
+// that hour (animations, animation frames, AppMessages, bluetooth drops). The
+// samples live in a small ring in persistent storage and are pulled by the
+// phone, which aggregates them (see pebble-js-app.js). The hour being
+// counted survives the face being unloaded (running_key), a sample is only
+// partial when the face missed the start or the end of its hour.
+
+#define TELEMETRY_SAMPLES      20   // ring size, must fit PERSIST_DATA_MAX_LENGTH
+#define TELEMETRY_CHUNK        4    // samples per AppMessage (64 byte outbox)
+#define TELEMETRY_FORMAT       1
+
+#define TELEMETRY_CHARGING     0x01 // charger was connected during the hour
+#define TELEMETRY_PARTIAL      0x02 // sample does not cover a full hour
+
+typedef enum
+{
+  TELEMETRY_APP_MESSAGE,
+  TELEMETRY_BT_FLAP,
+  TELEMETRY_COUNTER_COUNT
+} TelemetryCounter;
+
+typedef struct
+{
+  uint32_t time;          // end of the sample (unix time)
+  uint16_t animations;
+  uint16_t frames;
+  uint8_t  charge;        // percent at the end of the sample
+  uint8_t  flags;
+  uint8_t  app_messages;
+  uint8_t  bt_flaps;
+} __attribute__((__packed__)) TelemetrySample;
+
+void telemetry_init( uint32_t key, uint32_t running_key );
+void telemetry_deinit( void );
+
+void telemetry_count( TelemetryCounter counter );
+void telemetry_battery( BatteryChargeState charge );
+void telemetry_sample( uint32_t now );
+
+void telemetry_send( uint32_t since );
+
+#endif
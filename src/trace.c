@@ -0,0 +1,145 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /trace.c, created 2026-10-19 / */
+
+#include "trace.h"
+#include "msg_session.h"
+
+#if TRACE_ENABLED
+
+static TraceRecord ring[TRACE_RING_SIZE];
+static uint8_t ring_head = 0, ring_count = 0;
+static uint8_t dropped = 0;
+
+static uint32_t message_key = 0;
+static MsgRetry drain_retry;
+static bool phone_listening = false;
+
+static void _drain_chunk( void );
+
+static void _on_drain_timer( void *data __attribute__((__unused__)) )
+{
+  drain_retry.timer = 0;
+  _drain_chunk();
+}
+
+// records made before trace_init() are kept
+void trace_init( uint32_t key )
+{
+  message_key = key;
+}
+
+void trace_record( TraceEvent event, uint8_t arg0, uint16_t arg1 )
+{
+  time_t   sec;
+  uint16_t ms;
+  TraceRecord *rec;
+
+  time_ms( &sec, &ms );
+
+  if( ring_count == TRACE_RING_SIZE )
+  {
+    // oldest record gets overwritten, the phone sees the gap
+    ring_head = ( ring_head + 1 ) % TRACE_RING_SIZE;
+    --ring_count;
+    if( dropped < UINT8_MAX )
+    {
+      ++dropped;
+    }
+  }
+
+  rec = &ring[( ring_head + ring_count ) % TRACE_RING_SIZE];
+  rec->event = event;
+  rec->arg0  = arg0;
+  rec->arg1  = arg1;
+  rec->ms    = (uint32_t)sec * 1000 + ms;
+
+  // once the phone has asked for the ring a full ring is sent on its own,
+  // from a timer: the record may come from inside msg_session
+  if( ++ring_count == TRACE_RING_SIZE && phone_listening && drain_retry.timer == 0 )
+  {
+    msg_retry_next( &drain_retry, _on_drain_timer );
+  }
+}
+
+// The phone asks for the ring: a retry of an earlier request that gave up
+// starts over, and from now on a full ring drains itself.
+void trace_drain( void )
+{
+  phone_listening = true;
+  msg_retry_cancel( &drain_retry );
+  _drain_chunk();
+}
+
+// Sends the oldest records, one chunk per call, until the ring is empty.
+// Chunk layout: format, dropped count, then TraceRecords (little endian).
+static void _drain_chunk( void )
+{
+  uint8_t chunk[2 + TRACE_CHUNK_RECORDS * sizeof( TraceRecord )];
+  uint8_t i, count = ring_count < TRACE_CHUNK_RECORDS ? ring_count : TRACE_CHUNK_RECORDS;
+  DictionaryIterator *it;
+
+  if( count == 0 )
+  {
+    return;
+  }
+
+  if( ( it = msg_session_begin() ) == NULL )
+  {
+    // outbox busy, the records stay until the phone asks again
+    msg_retry_failed( &drain_retry, _on_drain_timer );
+    return;
+  }
+
+  chunk[0] = TRACE_FORMAT;
+  chunk[1] = dropped;
+  for( i = 0; i < count; ++i )
+  {
+    memcpy( &chunk[2 + i * sizeof( TraceRecord )],
+            &ring[( ring_head + i ) % TRACE_RING_SIZE], sizeof( TraceRecord ) );
+  }
+
+  dict_write_data( it, message_key, chunk, 2 + count * sizeof( TraceRecord ) );
+  dict_write_end( it );
+
+  if( !msg_session_send() )
+  {
+    msg_retry_failed( &drain_retry, _on_drain_timer );
+    return;
+  }
+
+  ring_head = ( ring_head + count ) % TRACE_RING_SIZE;
+  ring_count -= count;
+  dropped = 0;
+
+  if( ring_count > 0 )
+  {
+    msg_retry_next( &drain_retry, _on_drain_timer );
+  }
+}
+
+#endif
@@ -0,0 +1,106 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /trace.h, created 2026-10-19 / */
+
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include <pebble.h>
+
+// Binary event trace, cheap enough to stay on in release builds
+// (./waf configure --no-trace compiles it out).
+//
+// Events are kept in a fixed RAM ring and are only formatted on the phone:
+// the ring is sent as raw records over AppMessage when the phone asks for
+// it (a new value for the trace_dump appKey). Until then a full ring
+// overwrites its oldest records and the radio stays idle, after the first
+// request a full ring is sent on its own. pebble-js-app.js has the
+// decoder, its TRACE_EVENTS list is generated from the enum below
+// (tools/trace_events.py).
+
+#ifndef TRACE_ENABLED
+# define TRACE_ENABLED 1
+#endif
+
+#define TRACE_RING_SIZE     64   // records, 8 bytes each
+#define TRACE_CHUNK_RECORDS 6    // records per AppMessage (64 byte outbox)
+#define TRACE_FORMAT        1
+
+typedef enum
+{
+  TRACE_NONE = 0,
+  TRACE_MAIN,
+  TRACE_INIT,
+  TRACE_DEINIT,
+  TRACE_WINDOW_LOAD,
+  TRACE_WINDOW_UNLOAD,
+  TRACE_MINUTE_TICK,        // arg0: units_changed
+  TRACE_UPDATE_ROWS,        // arg0: units_changed, arg1: 1 = prepared plan
+  TRACE_COPY_TIME,
+  TRACE_UPDATE_IF_NEEDED,   // arg0: row
+  TRACE_PLAN_MINUTE_ROWS,
+  TRACE_APPLY_MINUTE_ROWS,
+  TRACE_TOGGLE_VIEW,        // arg0: storage key, arg1: new value
+  TRACE_TAP_GESTURE,        // arg0: axis
+  TRACE_TAP_TIMEOUT,
+  TRACE_BATTERY_CHANGE,     // arg0: percent, arg1: charging
+  TRACE_BLUETOOTH_CHANGE,   // arg0: connected
+  TRACE_CONF_KEY_CHANGED,   // arg0: SettingsField, arg1: value
+  TRACE_APP_MESSAGE_ERROR,  // arg0: dict error, arg1: app message error
+  TRACE_CONFIG_SEND_KEYS,
+  TRACE_CONFIG_INIT,
+  TRACE_CONFIG_DEINIT,
+  TRACE_INVALIDATE,         // arg0: InvalidFlags, arg1: events merged
+  TRACE_STACK_HIGH_WATER,   // arg0: StackProbeSite, arg1: bytes used
+  TRACE_STARTUP,            // arg0: StartupStage, arg1: ms since init()
+  TRACE_PREPARE_ROWS,       // arg0: units of the next minute, arg1: its tm_min
+  TRACE_EVENT_COUNT
+} TraceEvent;
+
+typedef struct
+{
+  uint8_t  event;
+  uint8_t  arg0;
+  uint16_t arg1;
+  uint32_t ms;      // milliseconds, wraps after ~49 days
+} __attribute__((__packed__)) TraceRecord;
+
+#if TRACE_ENABLED
+# define TRACE( ev )                trace_record( (ev), 0, 0 );
+# define TRACE_ARGS( ev, a0, a1 )   trace_record( (ev), (a0), (a1) );
+
+void trace_init( uint32_t message_key );
+void trace_record( TraceEvent event, uint8_t arg0, uint16_t arg1 );
+void trace_drain( void );
+#else
+# define TRACE( ev )
+# define TRACE_ARGS( ev, a0, a1 )
+# define trace_init( message_key )
+# define trace_drain()
+#endif
+
+#endif
@@ -0,0 +1,119 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /ui_arena.c, created 2026-10-19 / */
+
+#include "ui_arena.h"
+
+typedef struct
+{
+  void    *obj;
+  uint8_t  kind;
+} UiArenaSlot;
+
+static UiArenaSlot slots[UI_ARENA_SLOTS];
+static uint8_t live_by_kind[UI_ARENA_KIND_COUNT];
+static uint8_t live = 0, high_water = 0, sealed_level = 0;
+static bool sealed = false;
+
+void* ui_arena_put( UiArenaKind kind, void* obj )
+{
+  int i;
+
+  if( obj == NULL )
+  {
+    return NULL;
+  }
+
+  for( i = 0; i < UI_ARENA_SLOTS; ++i )
+  {
+    if( slots[i].obj == NULL )
+    {
+      slots[i].obj  = obj;
+      slots[i].kind = kind;
+
+      ++live_by_kind[kind];
+      if( ++live > high_water )
+      {
+        high_water = live;
+      }
+      if( sealed && live > sealed_level )
+      {
+        APP_LOG( APP_LOG_LEVEL_WARNING, "ui_arena: %d objects, %d at startup",
+                 live, sealed_level );
+      }
+      return obj;
+    }
+  }
+
+  APP_LOG( APP_LOG_LEVEL_ERROR, "ui_arena: no slot left for kind %d", kind );
+  return obj;
+}
+
+void* ui_arena_take( void* obj )
+{
+  int i;
+
+  for( i = 0; obj && i < UI_ARENA_SLOTS; ++i )
+  {
+    if( slots[i].obj == obj )
+    {
+      --live_by_kind[slots[i].kind];
+      --live;
+
+      slots[i].obj = NULL;
+      break;
+    }
+  }
+  return obj;
+}
+
+void ui_arena_seal( uint8_t reserved )
+{
+  sealed = true;
+  sealed_level = live + reserved;
+}
+
+uint8_t ui_arena_live( UiArenaKind kind )
+{
+  return kind < UI_ARENA_KIND_COUNT ? live_by_kind[kind] : live;
+}
+
+uint8_t ui_arena_high_water( void )
+{
+  return high_water;
+}
+
+void ui_arena_log( void )
+{
+  APP_LOG( APP_LOG_LEVEL_INFO,
+           "ui_arena: live %d / high-water %d / slots %d "
+           "(layer %d, text %d, inverter %d, bitmap %d, font %d)",
+           live, high_water, UI_ARENA_SLOTS,
+           live_by_kind[UI_ARENA_LAYER], live_by_kind[UI_ARENA_MOVIE_TEXT],
+           live_by_kind[UI_ARENA_INVERTER], live_by_kind[UI_ARENA_BITMAP],
+           live_by_kind[UI_ARENA_FONT] );
+}
@@ -0,0 +1,63 @@
+/* Copyright (c) 2026, the Filmplakat2 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* /ui_arena.h, created 2026-10-19 / */
+
+#ifndef __UI_ARENA_H
+#define __UI_ARENA_H
+
+#include <pebble.h>
+
+// Fixed table of every heap object the watchface owns.
+//
+// The SDK objects themselves are opaque and come from the SDK allocators,
+// the arena only reserves their slots statically and keeps the counts.
+// Objects are registered right after creation and released right before
+// destruction; once the arena is sealed (end of startup) any growth above
+// the startup level is logged, so a leak or a new runtime allocation shows
+// up immediately instead of as slow heap growth. Objects that are created
+// on demand later are announced as 'reserved' when sealing.
+typedef enum
+{
+  UI_ARENA_LAYER,
+  UI_ARENA_MOVIE_TEXT,  // Layer + its Animation
+  UI_ARENA_INVERTER,
+  UI_ARENA_BITMAP,
+  UI_ARENA_FONT,
+  UI_ARENA_KIND_COUNT
+} UiArenaKind;
+
+#define UI_ARENA_SLOTS 24
+
+void* ui_arena_put( UiArenaKind kind, void* obj );
+void* ui_arena_take( void* obj );
+void ui_arena_seal( uint8_t reserved );
+
+uint8_t ui_arena_live( UiArenaKind kind );  // UI_ARENA_KIND_COUNT: all kinds
+uint8_t ui_arena_high_water( void );
+void ui_arena_log( void );
+
+#endif
@@ -0,0 +1,308 @@
+#!/usr/bin/env python
+#
+# Renders the glyphs of the battery label ("0-9 % + .") from a TrueType
+# font into a 1-bit sprite sheet (PNG resource) and writes the matching
+# glyph table as a C header. Pure python, no PIL/freetype needed.
+#
+# Not part of the build: both outputs are checked in, run it by hand after
+# changing the font, the size or this script and commit the results.
+#
+#   digit_sprites.py resources/fonts/roboto/Roboto-Regular_9.ttf 9 \
+#       resources/images/battery_digits.png src/digit_sprites.h
+#
+
+import os
+import struct
+import sys
+import zlib
+
+GLYPHS = "0123456789%+."
+SUPERSAMPLE = 8
+
+#
+# TrueType parsing (only what simple glyphs need)
+#
+
+class Font(object):
+    def __init__(self, path, chars=GLYPHS):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        self.tables = {}
+        count = struct.unpack('>H', self.data[4:6])[0]
+        for i in range(count):
+            tag, _, offset, length = struct.unpack('>4sIII', self.data[12 + 16 * i:28 + 16 * i])
+            self.tables[tag.decode('ascii')] = (offset, length)
+
+        head = self.tables['head'][0]
+        self.units_per_em = struct.unpack('>H', self.data[head + 18:head + 20])[0]
+        self.loca_long = struct.unpack('>h', self.data[head + 50:head + 52])[0] == 1
+
+        hhea = self.tables['hhea'][0]
+        self.ascender = struct.unpack('>h', self.data[hhea + 4:hhea + 6])[0]
+        self.num_hmetrics = struct.unpack('>H', self.data[hhea + 34:hhea + 36])[0]
+
+        self.cmap = self._read_cmap(chars)
+
+    def _u16(self, offset):
+        return struct.unpack('>H', self.data[offset:offset + 2])[0]
+
+    def _i16(self, offset):
+        return struct.unpack('>h', self.data[offset:offset + 2])[0]
+
+    def _read_cmap(self, chars):
+        base = self.tables['cmap'][0]
+        for i in range(self._u16(base + 2)):
+            platform, encoding, offset = struct.unpack('>HHI', self.data[base + 4 + 8 * i:base + 12 + 8 * i])
+            if platform == 3 and encoding == 1 and self._u16(base + offset) == 4:
+                return self._read_cmap4(base + offset, chars)
+        raise ValueError('no unicode cmap (format 4) found')
+
+    def _read_cmap4(self, sub, chars):
+        segs = self._u16(sub + 6) // 2
+        ends = sub + 14
+        starts = ends + 2 * segs + 2
+        deltas = starts + 2 * segs
+        ranges = deltas + 2 * segs
+        cmap = {}
+        for ch in chars:
+            code = ord(ch)
+            for s in range(segs):
+                if self._u16(ends + 2 * s) >= code:
+                    start = self._u16(starts + 2 * s)
+                    delta = self._u16(deltas + 2 * s)
+                    range_offset = self._u16(ranges + 2 * s)
+                    if code < start:
+                        break
+                    if range_offset == 0:
+                        cmap[ch] = (code + delta) & 0xffff
+                    else:
+                        at = ranges + 2 * s + range_offset + 2 * (code - start)
+                        glyph = self._u16(at)
+                        cmap[ch] = (glyph + delta) & 0xffff if glyph else 0
+                    break
+        return cmap
+
+    def advance(self, glyph):
+        hmtx = self.tables['hmtx'][0]
+        return self._u16(hmtx + 4 * min(glyph, self.num_hmetrics - 1))
+
+    def contours(self, glyph):
+        loca = self.tables['loca'][0]
+        if self.loca_long:
+            start, end = struct.unpack('>II', self.data[loca + 4 * glyph:loca + 4 * glyph + 8])
+        else:
+            start, end = [2 * v for v in struct.unpack('>HH', self.data[loca + 2 * glyph:loca + 2 * glyph + 4])]
+        if start == end:
+            return []
+
+        at = self.tables['glyf'][0] + start
+        num_contours = self._i16(at)
+        if num_contours < 0:
+            return self._composite(at + 10)
+
+        end_points = [self._u16(at + 10 + 2 * i) for i in range(num_contours)]
+        num_points = end_points[-1] + 1
+        at += 10 + 2 * num_contours
+        at += 2 + self._u16(at)  # skip instructions
+
+        flags = []
+        while len(flags) < num_points:
+            flag = self.data[at] if isinstance(self.data[at], int) else ord(self.data[at])
+            at += 1
+            repeat = 0
+            if flag & 0x08:
+                repeat = self.data[at] if isinstance(self.data[at], int) else ord(self.data[at])
+                at += 1
+            flags.extend([flag] * (repeat + 1))
+
+        def coords(short_bit, same_bit):
+            values, value = [], 0
+            for flag in flags[:num_points]:
+                if flag & short_bit:
+                    delta = self.data[at_box[0]] if isinstance(self.data[at_box[0]], int) else ord(self.data[at_box[0]])
+                    at_box[0] += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += self._i16(at_box[0])
+                    at_box[0] += 2
+                values.append(value)
+            return values
+
+        at_box = [at]
+        xs = coords(0x02, 0x10)
+        ys = coords(0x04, 0x20)
+
+        result, first = [], 0
+        for last in end_points:
+            result.append([(xs[i], ys[i], bool(flags[i] & 0x01)) for i in range(first, last + 1)])
+            first = last + 1
+        return result
+
+    def _composite(self, at):
+        # accented letters: components placed at x/y offsets (no scaling,
+        # no point matching)
+        result = []
+        while True:
+            flags, component = self._u16(at), self._u16(at + 2)
+            at += 4
+            if flags & 0x0001:
+                dx, dy = self._i16(at), self._i16(at + 2)
+                at += 4
+            else:
+                dx, dy = struct.unpack('>bb', self.data[at:at + 2])
+                at += 2
+            if not flags & 0x0002:
+                raise ValueError('point matching in composite glyphs not supported')
+            at += 2 if flags & 0x0008 else 4 if flags & 0x0040 else 8 if flags & 0x0080 else 0
+
+            for contour in self.contours(component):
+                result.append([(x + dx, y + dy, on) for x, y, on in contour])
+            if not flags & 0x0020:
+                return result
+
+#
+# Rasterizer: quadratic outlines -> polygons -> supersampled non-zero fill
+#
+
+def flatten(contour, steps=8):
+    # insert the implied on-curve points between two off-curve points
+    points = []
+    for i, p in enumerate(contour):
+        q = contour[(i + 1) % len(contour)]
+        points.append(p)
+        if not p[2] and not q[2]:
+            points.append(((p[0] + q[0]) / 2.0, (p[1] + q[1]) / 2.0, True))
+
+    start = next(i for i, p in enumerate(points) if p[2])
+    points = points[start:] + points[:start]
+
+    polygon = [(points[0][0], points[0][1])]
+    i = 1
+    while i <= len(points):
+        p = points[i % len(points)]
+        if p[2]:
+            polygon.append((p[0], p[1]))
+            i += 1
+        else:
+            a = polygon[-1]
+            c = points[(i + 1) % len(points)]
+            for s in range(1, steps + 1):
+                t = s / float(steps)
+                polygon.append(((1 - t) ** 2 * a[0] + 2 * (1 - t) * t * p[0] + t * t * c[0],
+                                (1 - t) ** 2 * a[1] + 2 * (1 - t) * t * p[1] + t * t * c[1]))
+            i += 2
+    return polygon
+
+def coverage(polygons, width, height):
+    # coverage (0..1) per pixel, polygons already in pixel space (y down)
+    cover = [[0] * width for _ in range(height)]
+    for sy in range(height * SUPERSAMPLE):
+        y = (sy + 0.5) / SUPERSAMPLE
+        crossings = []
+        for polygon in polygons:
+            for i in range(len(polygon)):
+                x0, y0 = polygon[i]
+                x1, y1 = polygon[(i + 1) % len(polygon)]
+                if y0 == y1 or not (min(y0, y1) <= y < max(y0, y1)):
+                    continue
+                x = x0 + (y - y0) * (x1 - x0) / (y1 - y0)
+                crossings.append((x, 1 if y1 > y0 else -1))
+        crossings.sort()
+        winding = 0
+        for (x, direction), nxt in zip(crossings, crossings[1:] + [None]):
+            winding += direction
+            if winding != 0 and nxt is not None:
+                for sx in range(int(x * SUPERSAMPLE + 0.5), int(nxt[0] * SUPERSAMPLE + 0.5)):
+                    if 0 <= sx < width * SUPERSAMPLE:
+                        cover[sy // SUPERSAMPLE][sx // SUPERSAMPLE] += 1
+    full = float(SUPERSAMPLE * SUPERSAMPLE)
+    return [[c / full for c in row] for row in cover]
+
+def rasterize(outline, scale_x, scale_y, top, width, height):
+    # poor man's hinting: try sub-pixel x offsets and keep the sharpest
+    best = None
+    for step in range(SUPERSAMPLE):
+        dx = step / float(SUPERSAMPLE)
+        polygons = [[(x * scale_x + dx, top - y * scale_y) for x, y in flatten(c)] for c in outline]
+        cover = coverage(polygons, width, height)
+        sharpness = sum(abs(c - 0.5) for row in cover for c in row)
+        if best is None or sharpness > best[0]:
+            best = (sharpness, cover)
+    return [[1 if c >= 0.5 else 0 for c in row] for row in best[1]]
+
+#
+# Output
+#
+
+def write_png(path, pixels):
+    height, width = len(pixels), len(pixels[0])
+    raw = b''.join(b'\x00' + bytes(bytearray(255 if v else 0 for v in row)) for row in pixels)
+
+    def chunk(tag, body):
+        return (struct.pack('>I', len(body)) + tag + body +
+                struct.pack('>I', zlib.crc32(tag + body) & 0xffffffff))
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 0, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+def write_header(path, font_name, size, height, glyphs):
+    lines = [
+        '// generated by tools/digit_sprites.py from %s (%dpx), do not edit' % (font_name, size),
+        '',
+        '#ifndef __DIGIT_SPRITES_H',
+        '#define __DIGIT_SPRITES_H',
+        '',
+        '#define DIGIT_SPRITES_GLYPHS "%s"' % GLYPHS,
+        '#define DIGIT_SPRITES_HEIGHT %d' % height,
+        '',
+        '// x / width in the sheet, advance to the next glyph',
+        'static const struct { uint8_t x, w, advance; } DIGIT_SPRITES[] = {',
+    ]
+    for ch, (x, w, advance) in zip(GLYPHS, glyphs):
+        lines.append("  { %3d, %2d, %2d },  // '%s'" % (x, w, advance, ch))
+    lines += ['};', '', '#endif', '']
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+def render(font_path, size, png_path, header_path):
+    font = Font(font_path)
+    scale = size / float(font.units_per_em)
+
+    # snap the digit height to whole pixels, the baseline to a pixel edge
+    digit_top = max(y for contour in font.contours(font.cmap['0']) for x, y, on in contour)
+    digit_height = int(round(digit_top * scale))
+    scale_y = digit_height / float(digit_top)
+    top = digit_height + 1
+
+    cells = []
+    for ch in GLYPHS:
+        glyph = font.cmap[ch]
+        advance = int(round(font.advance(glyph) * scale))
+        cells.append((rasterize(font.contours(glyph), scale, scale_y, top, advance + 2, top + 2), advance))
+
+    # crop empty columns left/right and empty rows common to all glyphs
+    rows = [y for y in range(len(cells[0][0])) if any(any(c[0][y]) for c in cells)]
+    top, bottom = rows[0], rows[-1] + 1
+
+    sheet = [[] for _ in range(bottom - top)]
+    table, x = [], 0
+    for bitmap, advance in cells:
+        used = [col for col in range(len(bitmap[0])) if any(bitmap[y][col] for y in range(top, bottom))]
+        left, right = (used[0], used[-1] + 1) if used else (0, 1)
+        for y in range(top, bottom):
+            sheet[y - top].extend(bitmap[y][left:right])
+        table.append((x, right - left, max(advance, right - left + 1)))
+        x += right - left
+
+    write_png(png_path, sheet)
+    write_header(header_path, os.path.basename(font_path), size, bottom - top, table)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 5:
+        sys.stderr.write(__doc__ if __doc__ else 'usage: digit_sprites.py font.ttf size sheet.png table.h\n')
+        sys.exit(1)
+    render(sys.argv[1], int(sys.argv[2]), sys.argv[3], sys.argv[4])
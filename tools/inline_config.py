@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+#
+# Inlines the config page (config.html + pebble.css + config.js, images
+# as base64) into a single data: URI and substitutes it for the
+# @CONFIG_PAGE_URI@ placeholder in pebble-js-app.js. The phone can then
+# open the settings without a web server.
+#
+#   inline_config.py <pebble-js-app.js> <web dir> <output.js>
+#
+
+import base64
+import json
+import os
+import re
+import sys
+
+try:
+    from urllib import quote
+except ImportError:
+    from urllib.parse import quote
+
+PLACEHOLDER = '"@CONFIG_PAGE_URI@"'
+
+def _read(path):
+    with open(path, 'rb') as f:
+        return f.read().decode('utf-8')
+
+def _inline_images(css, web_dir):
+    def replace(match):
+        name = match.group(1)
+        with open(os.path.join(web_dir, name), 'rb') as f:
+            data = base64.b64encode(f.read()).decode('ascii')
+        return "url('data:image/svg+xml;base64,%s')" % data
+    return re.sub(r"url\('([^']+\.svg)'\)", replace, css)
+
+def page(web_dir):
+    html = _read(os.path.join(web_dir, 'config.html'))
+    css = _inline_images(_read(os.path.join(web_dir, 'pebble.css')), web_dir)
+    js = _read(os.path.join(web_dir, 'config.js'))
+
+    html = re.sub(r'<link[^>]*href="pebble.css"[^>]*>', lambda m: '<style>' + css + '</style>', html)
+    html = re.sub(r'<script[^>]*src="config.js"[^>]*></script>', lambda m: '<script>' + js + '</script>', html)
+
+    # indentation only, the page is small enough as it is
+    html = '\n'.join(line.strip() for line in html.splitlines() if line.strip())
+    return 'data:text/html;charset=utf-8,' + quote(html.encode('utf-8'), safe='')
+
+def substitute(source, web_dir):
+    if PLACEHOLDER not in source:
+        raise ValueError('no %s placeholder' % PLACEHOLDER)
+    return source.replace(PLACEHOLDER, json.dumps(page(web_dir)))
+
+def inline(app_js, web_dir, out_js):
+    with open(out_js, 'wb') as f:
+        f.write(substitute(_read(app_js), web_dir).encode('utf-8'))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        sys.stderr.write('usage: inline_config.py pebble-js-app.js web-dir output.js\n')
+        sys.exit(1)
+    inline(sys.argv[1], sys.argv[2], sys.argv[3])
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+#
+# Reads the settings record layout (SETTINGS_VERSION, SETTINGS_SCHEMA)
+# from src/settings_schema.h and substitutes it as JSON for the
+# @SETTINGS_SCHEMA@ placeholder in pebble-js-app.js, so watch and phone
+# pack the record from the same definition.
+#
+#   settings_schema.py <settings_schema.h> <pebble-js-app.js> <output.js>
+#
+
+import json
+import re
+import sys
+
+PLACEHOLDER = '"@SETTINGS_SCHEMA@"'
+
+def schema(header):
+    with open(header) as f:
+        text = f.read()
+
+    version = re.search(r'#define\s+SETTINGS_VERSION\s+(\d+)', text)
+    fields = re.findall(r'SETTING\(\s*(\w+)\s*,\s*"([^"]+)"\s*,\s*(\d+)\s*,\s*(\d+)\s*\)', text)
+    if not version or not fields:
+        raise ValueError('%s: no SETTINGS_VERSION / SETTING() entries' % header)
+
+    return {
+        'version': int(version.group(1)),
+        'fields': [{'name': name, 'bits': int(bits), 'default': int(default)}
+                   for _, name, bits, default in fields],
+    }
+
+def substitute(source, header):
+    if PLACEHOLDER not in source:
+        raise ValueError('no %s placeholder' % PLACEHOLDER)
+    return source.replace(PLACEHOLDER, json.dumps(schema(header)))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        sys.stderr.write('usage: settings_schema.py settings_schema.h pebble-js-app.js output.js\n')
+        sys.exit(1)
+    with open(sys.argv[2]) as f:
+        source = f.read()
+    with open(sys.argv[3], 'w') as f:
+        f.write(substitute(source, sys.argv[1]))
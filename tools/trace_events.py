@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+#
+# Reads the TraceEvent enum from src/trace.h and substitutes the event
+# names (TRACE_MINUTE_TICK -> "minute_tick") as a JSON list for the
+# @TRACE_EVENTS@ placeholder in pebble-js-app.js, so the phone decodes the
+# records with the watch's numbering.
+#
+#   trace_events.py <trace.h> <pebble-js-app.js> <output.js>
+#
+
+import json
+import re
+import sys
+
+PLACEHOLDER = '"@TRACE_EVENTS@"'
+
+def events(header):
+    with open(header) as f:
+        text = f.read()
+
+    body = re.search(r'typedef\s+enum\s*\{(.*?)\}\s*TraceEvent\s*;', text, re.S)
+    if not body:
+        raise ValueError('%s: no TraceEvent enum' % header)
+
+    names = []
+    for name, value in re.findall(r'^\s*TRACE_(\w+)\s*(?:=\s*(\d+))?\s*,?', body.group(1), re.M):
+        if value and int(value) != len(names):
+            raise ValueError('%s: TRACE_%s: only consecutive values are supported' % (header, name))
+        if name != 'EVENT_COUNT':
+            names.append(name.lower())
+    return names
+
+def substitute(source, header):
+    if PLACEHOLDER not in source:
+        raise ValueError('no %s placeholder' % PLACEHOLDER)
+    return source.replace(PLACEHOLDER, json.dumps(events(header)))
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        sys.stderr.write('usage: trace_events.py trace.h pebble-js-app.js output.js\n')
+        sys.exit(1)
+    with open(sys.argv[2]) as f:
+        source = f.read()
+    with open(sys.argv[3], 'w') as f:
+        f.write(substitute(source, sys.argv[1]))